@@ -1,9 +1,17 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <cstdlib>
-#include <ctime>
 #include <cmath>
+#include <chrono>
+#include <thread>
+#include <climits>
+
+#include "jssp.h"
+#include "fenwick_tree.h"
+#include "thread_pool.h"
+#include "pheromone_matrix.h"
+#include "random.h"
+#include "instance_loader.h"
 
 using namespace std;
 
@@ -14,13 +22,30 @@ const double ALPHA = 1.0;
 const double BETA = 2.0;
 const double EVAPORATION = 0.5;
 const double Q = 100.0;
-
-// Structure for a Task
-struct Task {
-    int jobID;
-    int machineID;
-    int duration;
-};
+const int MAX_REDRAWS = 4;  // Rejected roulette draws before scanning the remaining jobs
+
+// Ants are built in parallel in fixed blocks of ANTS_PER_BLOCK. Each block
+// sums its deposits in its own buffer and the buffers are merged in block
+// order, so results do not depend on the number of threads.
+const int NUM_THREADS = max(1, (int)thread::hardware_concurrency());
+const int ANTS_PER_BLOCK = 4;
+
+// Pheromone storage: floats, never below PHEROMONE_FLOOR. Lazy evaporation
+// decays a row only when it is read or receives a deposit.
+const bool LAZY_EVAPORATION = true;
+const float PHEROMONE_FLOOR = 1e-30f;
+
+// Max-Min Ant System: only the iteration-best ant deposits, or the best
+// solution so far every GLOBAL_BEST_INTERVAL iterations, and trails stay
+// within [tauMax / (2 * numJobs), tauMax] where tauMax = Q / (rho * best
+// makespan). Each decision is a roulette over the CANDIDATE_LIST_SIZE
+// unfinished jobs that can start earliest, and all trails are reset to
+// tauMax after STAGNATION_ITERATIONS iterations without improvement.
+const bool MAX_MIN_ANT_SYSTEM = false;
+const double MMAS_EVAPORATION = 0.1;
+const int CANDIDATE_LIST_SIZE = 5;
+const int GLOBAL_BEST_INTERVAL = 5;
+const int STAGNATION_ITERATIONS = 100;
 
 // Structure to represent a solution
 struct Solution {
@@ -28,47 +53,39 @@ struct Solution {
     int makespan;
 };
 
-// Random number generator
-unsigned int rng_seed = static_cast<unsigned int>(time(0));
-int randomInt(int max) {
-    rng_seed = rng_seed * 1103515245 + 12345;
-    return (rng_seed / 65536) % max;
-}
+// Master stream of the --seed value. It draws one seed per iteration, and
+// ant a builds its solution on stream a of that seed, so results do not
+// depend on which thread builds which ant.
+Random rng;
 
-// Example Job-Shop Scheduling problem data
-vector< vector<Task> > jobs; // Pre-C++11 style for nested vectors
+// Flat instance layout and shared evaluator
+Instance instance;
+Evaluator evaluator;
 
-// Number of jobs, machines, and tasks
+// Number of jobs and tasks
 int numJobs;
-int numMachines = 3;
 int numTasks;
 
-// Pheromone matrix
-vector< vector<double> > pheromone; // Pre-C++11 style for nested vectors
+// Pheromone matrix, position x job: ants read trail (pos, job) when
+// choosing the job for schedule position pos, and deposits for consecutive
+// jobs (a, b) go to trail (a, b), so no column beyond numJobs is ever used
+PheromoneMatrix pheromone;
+
+// Pheromone term of the selection weights: tau^ALPHA per (position, job)
+// with its row maxima in pheromoneRowMax, refreshed only when the
+// pheromones change
+vector<double> pheromoneWeight;
+vector<double> pheromoneRowMax;
 
 // Calculate the makespan of a schedule
 int calculateMakespan(const vector<int>& schedule) {
-    vector<int> machineTime(numMachines, 0);
-    vector<int> jobTime(numJobs, 0);
-
-    for (size_t i = 0; i < schedule.size(); ++i) { // No range-based for loop
-        int jobID = schedule[i];
-        for (size_t j = 0; j < jobs[jobID].size(); ++j) { // Replace range-based loop with standard loop
-            const Task& task = jobs[jobID][j];
-            int machineID = task.machineID;
-            int start = max(machineTime[machineID], jobTime[jobID]);
-            int end = start + task.duration;
-            machineTime[machineID] = end;
-            jobTime[jobID] = end;
-        }
-    }
-    return *max_element(machineTime.begin(), machineTime.end());
+    return evaluator.makespan(schedule);
 }
 
 // Custom shuffle function
 void customShuffle(vector<int>& vec) {
     for (int i = vec.size() - 1; i > 0; --i) {
-        int j = randomInt(i + 1);
+        int j = rng.below(i + 1);
         swap(vec[i], vec[j]);
     }
 }
@@ -76,139 +93,433 @@ void customShuffle(vector<int>& vec) {
 // Generate a random initial solution
 Solution generateInitialSolution() {
     Solution solution;
-    solution.schedule.resize(numJobs * numMachines);
-    for (int j = 0; j < numJobs; ++j) {
-        for (int k = 0; k < numMachines; ++k) {
-            solution.schedule[j * numMachines + k] = j;
-        }
-    }
+    initialSequence(instance, solution.schedule);
     customShuffle(solution.schedule);
     solution.makespan = calculateMakespan(solution.schedule);
     return solution;
 }
 
-// Generate a new solution for an ant using probabilistic selection
-Solution generateAntSolution() {
-    Solution solution;
-    vector<bool> visited(numJobs, false);
-    solution.schedule.clear();
+// Recompute pheromoneWeight and its row maxima for the first `rows` positions.
+// Selection only depends on the ratios within a row, so a row that merely
+// evaporated since its last refresh can keep its weights.
+void refreshPheromoneWeights(int rows) {
+    pheromoneWeight.resize((size_t)numTasks * numJobs);
+    pheromoneRowMax.resize(numTasks);
+    for (int pos = 0; pos < rows; ++pos) {
+        const float* trail = pheromone.row(pos);
+        double* weight = &pheromoneWeight[(size_t)pos * numJobs];
+        double rowMax = 0.0;
+        for (int j = 0; j < numJobs; ++j) {
+            weight[j] = ALPHA == 1.0 ? trail[j] : pow(trail[j], ALPHA);
+            rowMax = max(rowMax, weight[j]);
+        }
+        pheromoneRowMax[pos] = rowMax;
+    }
+}
 
-    for (int i = 0; i < numTasks; ++i) {
-        double sumProbabilities = 0.0;
-        vector<double> probabilities(numJobs, 0.0);
+// Partial schedule of an ant: machine and job completion times, the next
+// operation of each job, and per machine a list of the jobs whose next
+// operation runs on it. The roulette wheel holds the heuristic of every
+// unfinished job and starts its earliest start time (INT_MAX once the job
+// is finished); both only change for the scheduled job and the jobs waiting
+// on the machine it used.
+class AntState {
+public:
+    void init(const Instance& inst) {
+        instance = &inst;
+        machineTime.assign(inst.numMachines, 0);
+        jobTime.assign(inst.numJobs, 0);
+        nextOp.assign(inst.numJobs, 0);
+        waitingHead.assign(inst.numMachines, -1);
+        waitingNext.assign(inst.numJobs, -1);
+        waitingPrev.assign(inst.numJobs, -1);
+        heuristics.assign(inst.numJobs, 0.0);
+        wheel.init(inst.numJobs);
+        starts.assign(inst.numJobs, INT_MAX);
+    }
 
-        for (int j = 0; j < numJobs; ++j) {
-            if (!visited[j]) {
-                double pheromoneLevel = pow(pheromone[solution.schedule.size()][j], ALPHA);
-                // Fixing the issue with `{j}`. Use a proper vector with one element.
-                vector<int> singleJob(1, j);
-                double heuristicValue = pow(1.0 / (calculateMakespan(singleJob) + 1), BETA);
-                probabilities[j] = pheromoneLevel * heuristicValue;
-                sumProbabilities += probabilities[j];
+    // Empty schedule: every job waits for its first operation
+    void reset() {
+        fill(machineTime.begin(), machineTime.end(), 0);
+        fill(jobTime.begin(), jobTime.end(), 0);
+        fill(waitingHead.begin(), waitingHead.end(), -1);
+        currentMakespan = 0;
+        for (int j = 0; j < instance->numJobs; ++j) {
+            nextOp[j] = instance->jobOffset[j];
+            heuristics[j] = 0.0;
+            starts[j] = INT_MAX;
+            if (!finished(j)) {
+                enqueue(j);
+                heuristics[j] = heuristic(j);
+                starts[j] = 0;
             }
         }
+        wheel.build(heuristics.data());
+    }
 
-        double r = static_cast<double>(randomInt(10000)) / 10000.0 * sumProbabilities;
-        double cumulative = 0.0;
-        int nextJob = -1;
-        for (int j = 0; j < numJobs; ++j) {
-            cumulative += probabilities[j];
-            if (r <= cumulative) {
-                nextJob = j;
-                break;
+    bool finished(int j) const { return nextOp[j] == instance->jobOffset[j + 1]; }
+
+    // Earliest completion of job j's next operation on the partial schedule
+    int earliestFinish(int j) const {
+        return earliestStart(j) + instance->opDuration[nextOp[j]];
+    }
+
+    // Earliest start of job j's next operation on the partial schedule
+    int earliestStart(int j) const {
+        return max(machineTime[instance->opMachine[nextOp[j]]], jobTime[j]);
+    }
+
+    // eta^BETA of job j, from the earliest finish of its next operation
+    double heuristic(int j) const {
+        return pow(1.0 / (earliestFinish(j) + 1), BETA);
+    }
+
+    // Append job j's next operation and refresh the affected wheel weights
+    void schedule(int j) {
+        int op = nextOp[j];
+        int machineID = instance->opMachine[op];
+        int end = earliestFinish(j);
+        machineTime[machineID] = end;
+        jobTime[j] = end;
+        currentMakespan = max(currentMakespan, end);
+
+        dequeue(j, machineID);
+        ++nextOp[j];
+        if (finished(j)) {
+            wheel.set(j, 0.0);
+            starts[j] = INT_MAX;
+        } else {
+            enqueue(j);
+            wheel.set(j, heuristic(j));
+            starts[j] = earliestStart(j);
+        }
+        for (int k = waitingHead[machineID]; k >= 0; k = waitingNext[k]) {
+            wheel.set(k, heuristic(k));
+            starts[k] = earliestStart(k);
+        }
+    }
+
+    // The k unfinished jobs whose next operations can start earliest, ties
+    // going to the lower job ID. One pass keeps the best k sorted by start.
+    const vector<int>& candidates(int k) {
+        candidateList.resize(k);
+        candidateStart.assign(k, INT_MAX);
+        int count = 0;
+        for (int j = 0; j < instance->numJobs; ++j) {
+            int start = starts[j];
+            if (start >= candidateStart[k - 1]) {
+                continue;
+            }
+            int c = min(count, k - 1);
+            for (; c > 0 && candidateStart[c - 1] > start; --c) {
+                candidateList[c] = candidateList[c - 1];
+                candidateStart[c] = candidateStart[c - 1];
             }
+            candidateList[c] = j;
+            candidateStart[c] = start;
+            count = min(count + 1, k);
         }
+        candidateList.resize(count);
+        return candidateList;
+    }
+
+    const FenwickTree& weights() const { return wheel; }
+    int makespan() const { return currentMakespan; }
 
-        visited[nextJob] = true;
-        solution.schedule.push_back(nextJob);
+private:
+    void enqueue(int j) {
+        int machineID = instance->opMachine[nextOp[j]];
+        waitingPrev[j] = -1;
+        waitingNext[j] = waitingHead[machineID];
+        if (waitingHead[machineID] >= 0) {
+            waitingPrev[waitingHead[machineID]] = j;
+        }
+        waitingHead[machineID] = j;
     }
 
-    solution.makespan = calculateMakespan(solution.schedule);
-    return solution;
+    void dequeue(int j, int machineID) {
+        if (waitingPrev[j] >= 0) {
+            waitingNext[waitingPrev[j]] = waitingNext[j];
+        } else {
+            waitingHead[machineID] = waitingNext[j];
+        }
+        if (waitingNext[j] >= 0) {
+            waitingPrev[waitingNext[j]] = waitingPrev[j];
+        }
+    }
+
+    const Instance* instance;
+    int currentMakespan;
+    vector<int> machineTime;
+    vector<int> jobTime;
+    vector<int> nextOp;
+    vector<int> waitingHead;   // First waiting job per machine, -1 if none
+    vector<int> waitingNext;
+    vector<int> waitingPrev;
+    vector<double> heuristics;
+    FenwickTree wheel;
+    vector<int> starts;
+    vector<int> candidateList;
+    vector<int> candidateStart;  // Earliest start of each candidate, ascending
+};
+
+vector<AntState> antStates;  // One per thread
+
+// Roulette-wheel choice of an unfinished job for position pos, with
+// probability proportional to tau^ALPHA * eta^BETA. A job is drawn from the
+// heuristic wheel in O(log n) and kept with probability
+// tau^ALPHA / (row maximum), which samples exactly from the full product.
+// After MAX_REDRAWS rejections the remaining jobs are scanned directly.
+int selectJob(int pos, const AntState& ant, Random& random) {
+    const FenwickTree& wheel = ant.weights();
+    const double* weight = &pheromoneWeight[(size_t)pos * numJobs];
+    double rowMax = pheromoneRowMax[pos];
+    double total = wheel.total();
+    for (int attempt = 0; attempt < MAX_REDRAWS && rowMax > 0.0; ++attempt) {
+        int j = wheel.find(random.unit() * total);
+        if (!ant.finished(j) && random.unit() * rowMax < weight[j]) {
+            return j;
+        }
+    }
+
+    double sumWeights = 0.0;
+    int lastRemaining = -1;
+    for (int j = 0; j < numJobs; ++j) {
+        if (!ant.finished(j)) {
+            sumWeights += weight[j] * wheel.weight(j);
+            lastRemaining = j;
+        }
+    }
+    double r = random.unit() * sumWeights;
+    double cumulative = 0.0;
+    for (int j = 0; j < numJobs; ++j) {
+        if (!ant.finished(j)) {
+            cumulative += weight[j] * wheel.weight(j);
+            if (r < cumulative) {
+                return j;
+            }
+        }
+    }
+    return lastRemaining;
 }
 
-// Update pheromones
-void updatePheromone(const vector<Solution>& solutions) {
+// Roulette-wheel choice among the candidate list of position pos, with
+// probability proportional to tau^ALPHA * eta^BETA
+int selectCandidate(int pos, AntState& ant, Random& random) {
+    const vector<int>& candidates = ant.candidates(CANDIDATE_LIST_SIZE);
+    const FenwickTree& wheel = ant.weights();
+    const double* weight = &pheromoneWeight[(size_t)pos * numJobs];
+    double sumWeights = 0.0;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        sumWeights += weight[candidates[c]] * wheel.weight(candidates[c]);
+    }
+    double r = random.unit() * sumWeights;
+    double cumulative = 0.0;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        cumulative += weight[candidates[c]] * wheel.weight(candidates[c]);
+        if (r < cumulative) {
+            return candidates[c];
+        }
+    }
+    return candidates.back();
+}
+
+// Generate a new solution for an ant in place, scheduling each chosen
+// operation as it goes so the makespan is known when construction ends
+void generateAntSolution(Solution& solution, AntState& ant, Random& random) {
+    solution.schedule.resize(numTasks);
+    ant.reset();
+
     for (int i = 0; i < numTasks; ++i) {
-        for (int j = 0; j < numTasks; ++j) {
-            pheromone[i][j] *= (1 - EVAPORATION);
+        int nextJob = MAX_MIN_ANT_SYSTEM ? selectCandidate(i, ant, random) : selectJob(i, ant, random);
+        ant.schedule(nextJob);
+        solution.schedule[i] = nextJob;
+    }
+
+    solution.makespan = ant.makespan();
+}
+
+// Add a solution's deposits to a job x job buffer
+void depositPheromone(const Solution& solution, vector<double>& deposits) {
+    for (size_t j = 0; j + 1 < solution.schedule.size(); ++j) {
+        int jobA = solution.schedule[j];
+        int jobB = solution.schedule[j + 1];
+        deposits[jobA * numJobs + jobB] += Q / solution.makespan;
+    }
+}
+
+// Update pheromones: evaporate, then merge the block deposits in block order
+void updatePheromone(const vector< vector<double> >& deposits) {
+    pheromone.evaporate();
+
+    for (int jobA = 0; jobA < numJobs; ++jobA) {
+        for (int jobB = 0; jobB < numJobs; ++jobB) {
+            double sum = 0.0;
+            for (size_t b = 0; b < deposits.size(); ++b) {
+                sum += deposits[b][jobA * numJobs + jobB];
+            }
+            if (sum > 0.0) {
+                pheromone.deposit(jobA, jobB, (float)sum);
+            }
         }
     }
+}
+
+// Max-Min update: evaporate, then deposit for a single solution; the
+// matrix clamps every trail to the current bounds
+void updateMaxMinPheromone(const Solution& solution) {
+    pheromone.evaporate();
+    for (size_t j = 0; j + 1 < solution.schedule.size(); ++j) {
+        pheromone.deposit(solution.schedule[j], solution.schedule[j + 1], (float)(Q / solution.makespan));
+    }
+}
+
+// Max-Min trail limits for the best makespan found so far
+void setPheromoneBounds(int bestMakespan) {
+    double tauMax = Q / (MMAS_EVAPORATION * bestMakespan);
+    pheromone.setBounds((float)(tauMax / (2.0 * numJobs)), (float)tauMax);
+}
 
-    for (size_t i = 0; i < solutions.size(); ++i) {
-        const Solution& solution = solutions[i];
-        for (size_t j = 0; j < solution.schedule.size() - 1; ++j) {
-            int jobA = solution.schedule[j];
-            int jobB = solution.schedule[j + 1];
-            pheromone[jobA][jobB] += Q / solution.makespan;
+// Max-Min Ant System variant of antColonyOptimization
+Solution maxMinAntSystem(int& reinitializations) {
+    Solution bestSolution = generateInitialSolution();
+    setPheromoneBounds(bestSolution.makespan);
+    pheromone.reset(Q / (MMAS_EVAPORATION * bestSolution.makespan));
+    refreshPheromoneWeights(numTasks);
+    reinitializations = 0;
+
+    // Deposits only reach the first numJobs rows, as in the Ant System
+    int refreshedRows = LAZY_EVAPORATION ? min(numJobs, numTasks) : numTasks;
+
+    ThreadPool pool(NUM_THREADS);
+    vector<Solution> antSolutions(NUM_ANTS);
+    int lastImprovement = 0;
+
+    for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+        uint64_t iterationSeed = rng();
+
+        pool.parallelFor(NUM_ANTS, 1, [&](int begin, int end, int thread) {
+            for (int ant = begin; ant < end; ++ant) {
+                Random random(iterationSeed, ant);
+                generateAntSolution(antSolutions[ant], antStates[thread], random);
+            }
+        });
+
+        int iterationBest = 0;
+        for (int ant = 1; ant < NUM_ANTS; ++ant) {
+            if (antSolutions[ant].makespan < antSolutions[iterationBest].makespan) {
+                iterationBest = ant;
+            }
+        }
+
+        // A new best raises tauMax = Q / (rho * best) and with it tauMin, and
+        // the higher floor may clamp any row
+        int rows = refreshedRows;
+        if (antSolutions[iterationBest].makespan < bestSolution.makespan) {
+            bestSolution = antSolutions[iterationBest];
+            lastImprovement = iteration;
+            setPheromoneBounds(bestSolution.makespan);
+            rows = numTasks;
         }
+
+        bool useGlobalBest = (iteration + 1) % GLOBAL_BEST_INTERVAL == 0;
+        updateMaxMinPheromone(useGlobalBest ? bestSolution : antSolutions[iterationBest]);
+
+        if (iteration - lastImprovement >= STAGNATION_ITERATIONS) {
+            pheromone.reset(Q / (MMAS_EVAPORATION * bestSolution.makespan));
+            lastImprovement = iteration;
+            ++reinitializations;
+            rows = numTasks;
+        }
+        refreshPheromoneWeights(rows);
     }
+
+    return bestSolution;
 }
 
 // Main Ant Colony Optimization function
 Solution antColonyOptimization() {
     Solution bestSolution = generateInitialSolution();
+    refreshPheromoneWeights(numTasks);
+
+    // Only the first numJobs rows receive deposits; with eager evaporation
+    // the floor can change the ratios in any row, so all rows are refreshed
+    int refreshedRows = LAZY_EVAPORATION ? min(numJobs, numTasks) : numTasks;
+
+    ThreadPool pool(NUM_THREADS);
+    int numBlocks = (NUM_ANTS + ANTS_PER_BLOCK - 1) / ANTS_PER_BLOCK;
+    vector<Solution> antSolutions(NUM_ANTS);
+    vector< vector<double> > deposits(numBlocks, vector<double>(numJobs * numJobs));
 
     for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
-        vector<Solution> antSolutions;
+        uint64_t iterationSeed = rng();
+
+        // Ants only read the pheromones, which stay fixed during the iteration
+        pool.parallelFor(numBlocks, 1, [&](int begin, int end, int thread) {
+            for (int b = begin; b < end; ++b) {
+                fill(deposits[b].begin(), deposits[b].end(), 0.0);
+                for (int ant = b * ANTS_PER_BLOCK; ant < min(NUM_ANTS, (b + 1) * ANTS_PER_BLOCK); ++ant) {
+                    Random random(iterationSeed, ant);
+                    generateAntSolution(antSolutions[ant], antStates[thread], random);
+                    depositPheromone(antSolutions[ant], deposits[b]);
+                }
+            }
+        });
 
         for (int ant = 0; ant < NUM_ANTS; ++ant) {
-            Solution antSolution = generateAntSolution();
-            antSolutions.push_back(antSolution);
-
-            if (antSolution.makespan < bestSolution.makespan) {
-                bestSolution = antSolution;
+            if (antSolutions[ant].makespan < bestSolution.makespan) {
+                bestSolution = antSolutions[ant];
             }
         }
 
-        updatePheromone(antSolutions);
+        updatePheromone(deposits);
+        refreshPheromoneWeights(refreshedRows);
     }
 
     return bestSolution;
 }
 
-int main() {
-    // Initialize jobs data manually without C++11 initializer lists
-    jobs.resize(3);
-    // Initialize jobs data manually without C++11 initializer lists
-    Task task1 = {0, 0, 3};
-    Task task2 = {0, 1, 2};
-    Task task3 = {0, 2, 2};
-    jobs[0].push_back(task1);
-    jobs[0].push_back(task2);
-    jobs[0].push_back(task3);
-
-    Task task4 = {1, 0, 2};
-    Task task5 = {1, 1, 1};
-    Task task6 = {1, 2, 4};
-    jobs[1].push_back(task4);
-    jobs[1].push_back(task5);
-    jobs[1].push_back(task6);
-
-    Task task7 = {2, 0, 4};
-    Task task8 = {2, 1, 3};
-    Task task9 = {2, 2, 3};
-    jobs[2].push_back(task7);
-    jobs[2].push_back(task8);
-    jobs[2].push_back(task9);
-
-    numJobs = jobs.size();
-    numTasks = numJobs * numMachines;
-
-    // Initialize the pheromone matrix
-    pheromone.resize(numTasks);
-    for (int i = 0; i < numTasks; ++i) {
-        pheromone[i].resize(numTasks, 1.0);
+int main(int argc, char** argv) {
+    uint64_t masterSeed = parseSeed(argc, argv);
+    cout << "Seed: " << masterSeed << endl;
+
+    vector<NamedInstance> instances;
+    if (!loadCommandLineInstances(argc, argv, instances)) {
+        return 1;
     }
 
-    // Run Ant Colony Optimization
-    clock_t start = clock();
-    Solution bestSolution = antColonyOptimization();
-    clock_t end = clock();
+    // Every instance starts from the master seed, so its result does not
+    // depend on the instances before it
+    for (size_t k = 0; k < instances.size(); ++k) {
+        instance = move(instances[k].instance);
+        cout << "Instance: " << instances[k].name << " (" << instance.numJobs << "x"
+             << instance.numMachines << ")" << endl;
+        rng.seed(masterSeed);
+        evaluator.init(instance);
+        numJobs = instance.numJobs;
+        numTasks = instance.numOps;
+        antStates.resize(NUM_THREADS);
+        for (int t = 0; t < NUM_THREADS; ++t) {
+            antStates[t].init(instance);
+        }
 
-    double duration = (double)(end - start) / CLOCKS_PER_SEC * 1000;
-    cout << "Best makespan: " << bestSolution.makespan << endl;
-    cout << "Execution time: " << duration << " ms" << endl;
+        // Initialize the pheromone matrix
+        pheromone.init(numTasks, numJobs, 1.0f, MAX_MIN_ANT_SYSTEM ? MMAS_EVAPORATION : EVAPORATION,
+                       LAZY_EVAPORATION, PHEROMONE_FLOOR);
+
+        // Run Ant Colony Optimization (wall-clock time, as it may use several threads)
+        int reinitializations = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        Solution bestSolution = MAX_MIN_ANT_SYSTEM ? maxMinAntSystem(reinitializations) : antColonyOptimization();
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+        double duration = chrono::duration<double, milli>(end - start).count();
+        cout << "Best makespan: " << bestSolution.makespan << endl;
+        cout << "Execution time: " << duration << " ms" << endl;
+        if (MAX_MIN_ANT_SYSTEM) {
+            cout << "Pheromone reinitializations: " << reinitializations << endl;
+        }
+    }
 
     return 0;
 }
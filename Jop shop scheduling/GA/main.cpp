@@ -1,9 +1,21 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <cstdlib>
-#include <ctime>
-#include <random>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <climits>
+#include <cmath>
+#include <functional>
+
+#include "jssp.h"
+#include "thread_pool.h"
+#include "mailbox.h"
+#include "zobrist.h"
+#include "fitness_cache.h"
+#include "random.h"
+#include "instance_loader.h"
+#include "batch_evaluator.h"
 
 using namespace std;
 
@@ -13,12 +25,28 @@ const int MAX_GENERATIONS = 1000;
 const double CROSSOVER_RATE = 0.8;
 const double MUTATION_RATE = 0.1;
 
-// Structure for a Task
-struct Task {
-    int jobID;
-    int machineID;
-    int duration;
-};
+// Offspring pairs are bred in parallel, PAIRS_PER_CHUNK at a time per thread
+const int NUM_THREADS = max(1, (int)thread::hardware_concurrency());
+const int PAIRS_PER_CHUNK = 8;
+
+// Island model: NUM_ISLANDS populations of ISLAND_SIZE evolve on their own
+// threads and send their MIGRATION_SIZE best individuals to their neighbors
+// every MIGRATION_INTERVAL generations
+enum MigrationTopology { RING, FULLY_CONNECTED, RANDOM_NEIGHBOR };
+const bool ISLAND_MODEL = false;
+const int NUM_ISLANDS = max(2, NUM_THREADS);
+const int ISLAND_SIZE = POPULATION_SIZE;
+const int MIGRATION_INTERVAL = 20;
+const int MIGRATION_SIZE = 2;
+const MigrationTopology TOPOLOGY = RING;
+
+// Offspring are only decoded when changed and not found in the fitness cache
+const int FITNESS_CACHE_LOG2 = 16;          // Cache entries (power of two)
+
+// Batch evaluation: the offspring that still need decoding after breeding
+// are decoded together, BatchEvaluator::LANES per SIMD group
+const bool BATCH_EVALUATION = false;
+const bool REPORT_BATCH_THROUGHPUT = false;  // Compare schedules/sec of every kernel
 
 // Structure to represent a solution (individual)
 struct Solution {
@@ -26,46 +54,106 @@ struct Solution {
     int makespan;
 };
 
-// Random number generator (using std::mt19937)
-random_device rd;
-mt19937 rng(rd());
+// Fitness bookkeeping of a chromosome: hash is its Zobrist fingerprint and
+// dirty means it changed since makespan was computed
+struct Fitness {
+    int makespan;
+    bool dirty;
+    uint64_t hash;
+};
+
+// Two populations of chromosomes in one contiguous block. Offspring are
+// written straight into the back buffer, which becomes the population when
+// the generation is complete, so nothing is allocated after init(). Each
+// buffer has an even number of slots because offspring come in pairs.
+class PopulationArena {
+public:
+    PopulationArena() : populationSize(0), slots(0), length(0), front(0) {}
+
+    void init(int size, int scheduleLength) {
+        populationSize = size;
+        slots = size + (size & 1);
+        length = scheduleLength;
+        front = 0;
+        genes.assign((size_t)2 * slots * length, 0);
+        Fitness clean = {0, false, 0};
+        fitnesses.assign(2 * slots, clean);
+    }
+
+    int size() const { return populationSize; }
+
+    // Members of the current population
+    const int* schedule(int i) const { return &genes[((size_t)front * slots + i) * length]; }
+    int* schedule(int i) { return &genes[((size_t)front * slots + i) * length]; }
+    const Fitness& fitness(int i) const { return fitnesses[front * slots + i]; }
+    Fitness& fitness(int i) { return fitnesses[front * slots + i]; }
+    int makespan(int i) const { return fitness(i).makespan; }
+
+    // Slots of the next population
+    int* offspringSchedule(int i) { return &genes[((size_t)(1 - front) * slots + i) * length]; }
+    Fitness& offspringFitness(int i) { return fitnesses[(1 - front) * slots + i]; }
+
+    // Make the offspring the current population
+    void swapBuffers() { front = 1 - front; }
+
+private:
+    int populationSize;
+    int slots;
+    int length;
+    int front;
+    vector<int> genes;
+    vector<Fitness> fitnesses;
+};
+
+// How the makespans of bred offspring were obtained
+struct EvaluationStats {
+    long long evaluations;  // Decoded
+    long long cacheHits;    // Changed, but found in the fitness cache
+    long long unchanged;    // Identical to a parent, makespan inherited
+
+    EvaluationStats() : evaluations(0), cacheHits(0), unchanged(0) {}
+
+    void add(const EvaluationStats& other) {
+        evaluations += other.evaluations;
+        cacheHits += other.cacheHits;
+        unchanged += other.unchanged;
+    }
+};
+
+// Scratch space of one breeding thread
+struct BreedingWorkspace {
+    Evaluator evaluator;
+    BatchEvaluator batch;
+    vector<int> taken;      // Per-job operation counts for orderedFill
+    EvaluationStats stats;
+};
 
-// Example Job-Shop Scheduling problem data
-vector<vector<Task> > jobs;  // Space between '>' required for pre-C++11
+// Master stream of the --seed value; it draws the seed of every generation,
+// and stream p of that seed breeds pair p, so a pair draws the same numbers
+// no matter which thread breeds it
+Random rng;
 
-// Number of jobs, machines, and tasks
+// Flat instance layout and shared evaluator
+Instance instance;
+Evaluator evaluator;
+vector<BreedingWorkspace> workspaces;  // One per thread
+ZobristTable zobrist;                  // Position x job keys for chromosome hashes
+FitnessCache fitnessCache;
+EvaluationStats evaluationStats;       // Totals of the finished run
+
+// Number of jobs and tasks
 int numJobs;
-int numMachines = 3;
 int numTasks;
 
 // Calculate the makespan of a schedule
 int calculateMakespan(const vector<int>& schedule) {
-    vector<int> machineTime(numMachines, 0);
-    vector<int> jobTime(numJobs, 0);
-
-    for (size_t i = 0; i < schedule.size(); ++i) {
-        int jobID = schedule[i];
-        for (size_t j = 0; j < jobs[jobID].size(); ++j) {
-            const Task& task = jobs[jobID][j];
-            int machineID = task.machineID;
-            int start = max(machineTime[machineID], jobTime[jobID]);
-            int end = start + task.duration;
-            machineTime[machineID] = end;
-            jobTime[jobID] = end;
-        }
-    }
-    return *max_element(machineTime.begin(), machineTime.end());
+    return evaluator.makespan(schedule);
 }
 
 // Generate a random initial solution
 Solution generateInitialSolution() {
     Solution solution;
-    solution.schedule.resize(numJobs * numMachines);
-    for (int j = 0; j < numJobs; ++j) {
-        for (int k = 0; k < numMachines; ++k) {
-            solution.schedule[j * numMachines + k] = j;
-        }
-    }
+    initialSequence(instance, solution.schedule);
     
     // Use std::shuffle instead of random_shuffle
     std::shuffle(solution.schedule.begin(), solution.schedule.end(), rng);
@@ -74,126 +162,482 @@ Solution generateInitialSolution() {
     return solution;
 }
 
-// Tournament selection
-Solution tournamentSelection(const vector<Solution>& population) {
+// Tournament selection; returns the index of the winner
+int tournamentSelection(const PopulationArena& population, Random& random) {
     int tournamentSize = 3;
-    Solution best = population[rng() % POPULATION_SIZE];
+    int best = random.below(population.size());
     for (int i = 1; i < tournamentSize; ++i) {
-        Solution contender = population[rng() % POPULATION_SIZE];
-        if (contender.makespan < best.makespan) {
+        int contender = random.below(population.size());
+        if (population.makespan(contender) < population.makespan(best)) {
             best = contender;
         }
     }
     return best;
 }
 
-// Crossover two parents to produce two offspring
-pair<Solution, Solution> crossover(const Solution& parent1, const Solution& parent2) {
-    Solution offspring1 = parent1;
-    Solution offspring2 = parent2;
+// Fill child with donor's prefix followed by the remaining operations in other's order
+void orderedFill(const int* donor, const int* other, int crossoverPoint,
+                 int* child, vector<int>& taken) {
+    fill(taken.begin(), taken.end(), 0);
+    for (int i = 0; i < crossoverPoint; ++i) {
+        child[i] = donor[i];
+        ++taken[donor[i]];
+    }
+    int pos = crossoverPoint;
+    for (int i = 0; i < numTasks; ++i) {
+        int jobID = other[i];
+        if (taken[jobID] > 0) {
+            --taken[jobID];
+        } else {
+            child[pos++] = jobID;
+        }
+    }
+}
+
+// Crossover two parents into the offspring slots child and child + 1
+void crossover(PopulationArena& population, int parent1, int parent2, int child,
+               Random& random, BreedingWorkspace& workspace) {
+    const int* schedule1 = population.schedule(parent1);
+    const int* schedule2 = population.schedule(parent2);
+    int* offspring1 = population.offspringSchedule(child);
+    int* offspring2 = population.offspringSchedule(child + 1);
+
+    if (random.unit() < CROSSOVER_RATE) {
+        int crossoverPoint = random.below(numTasks);
+
+        // Swap prefixes, keeping each job's operation count intact
+        orderedFill(schedule2, schedule1, crossoverPoint, offspring1, workspace.taken);
+        orderedFill(schedule1, schedule2, crossoverPoint, offspring2, workspace.taken);
+
+        Fitness& fitness1 = population.offspringFitness(child);
+        Fitness& fitness2 = population.offspringFitness(child + 1);
+        fitness1.hash = zobrist.hash(offspring1, numTasks);
+        fitness2.hash = zobrist.hash(offspring2, numTasks);
+        fitness1.dirty = fitness2.dirty = true;
+    } else {
+        // Exact copies keep their parents' makespans
+        copy(schedule1, schedule1 + numTasks, offspring1);
+        copy(schedule2, schedule2 + numTasks, offspring2);
+        population.offspringFitness(child) = population.fitness(parent1);
+        population.offspringFitness(child + 1) = population.fitness(parent2);
+    }
+}
+
+// Mutate a schedule; swapping two equal job IDs leaves it clean
+void mutate(int* schedule, Fitness& fitness, Random& random) {
+    if (random.unit() < MUTATION_RATE) {
+        int index1 = random.below(numTasks);
+        int index2 = random.below(numTasks);
+        if (schedule[index1] != schedule[index2]) {
+            fitness.hash ^= zobrist.swapDelta(index1, schedule[index1], index2, schedule[index2]);
+            swap(schedule[index1], schedule[index2]);
+            fitness.dirty = true;
+        }
+    }
+}
+
+// Give a bred chromosome its makespan without decoding: clean ones already
+// have it and dirty ones are looked up in the fitness cache. Returns false
+// (leaving it dirty) if it has to be decoded.
+bool resolveOffspring(Fitness& fitness, BreedingWorkspace& workspace) {
+    if (!fitness.dirty) {
+        ++workspace.stats.unchanged;
+        return true;
+    }
+    if (fitnessCache.lookup(fitness.hash, fitness.makespan)) {
+        fitness.dirty = false;
+        ++workspace.stats.cacheHits;
+        return true;
+    }
+    return false;
+}
 
-    if ((double)(rng() % 100) / 100.0 < CROSSOVER_RATE) {
-        int crossoverPoint = rng() % numTasks;
+// Give a bred chromosome its makespan, decoding it on a cache miss
+void evaluateOffspring(const int* schedule, Fitness& fitness, BreedingWorkspace& workspace) {
+    if (resolveOffspring(fitness, workspace)) {
+        return;
+    }
+    fitness.makespan = workspace.evaluator.makespan(schedule, numTasks);
+    fitness.dirty = false;
+    fitnessCache.insert(fitness.hash, fitness.makespan);
+    ++workspace.stats.evaluations;
+}
 
-        for (int i = 0; i < crossoverPoint; ++i) {
-            swap(offspring1.schedule[i], offspring2.schedule[i]);
+// Offspring slots of the back buffer still dirty after breeding
+void collectPending(PopulationArena& population, int numPairs, vector<int>& pending) {
+    pending.clear();
+    for (int c = 0; c < 2 * numPairs; ++c) {
+        if (population.offspringFitness(c).dirty) {
+            pending.push_back(c);
         }
     }
+}
 
-    offspring1.makespan = calculateMakespan(offspring1.schedule);
-    offspring2.makespan = calculateMakespan(offspring2.schedule);
+// Decode pending[begin, end) as one batch, at most BatchEvaluator::LANES
+void decodePending(PopulationArena& population, const vector<int>& pending, int begin, int end,
+                   BreedingWorkspace& workspace) {
+    const int* schedules[BatchEvaluator::LANES] = {};
+    int makespans[BatchEvaluator::LANES];
+    for (int k = begin; k < end; ++k) {
+        schedules[k - begin] = population.offspringSchedule(pending[k]);
+    }
+    workspace.batch.evaluate(schedules, end - begin, makespans);
+    for (int k = begin; k < end; ++k) {
+        Fitness& fitness = population.offspringFitness(pending[k]);
+        fitness.makespan = makespans[k - begin];
+        fitness.dirty = false;
+        fitnessCache.insert(fitness.hash, fitness.makespan);
+        ++workspace.stats.evaluations;
+    }
+}
 
-    return make_pair(offspring1, offspring2);
+// Fill a population of the given size with random solutions
+void initPopulation(PopulationArena& population, int size) {
+    population.init(size, numTasks);
+    for (int i = 0; i < size; ++i) {
+        Solution solution = generateInitialSolution();
+        copy(solution.schedule.begin(), solution.schedule.end(), population.schedule(i));
+        Fitness& fitness = population.fitness(i);
+        fitness.makespan = solution.makespan;
+        fitness.dirty = false;
+        fitness.hash = zobrist.hash(population.schedule(i), numTasks);
+        fitnessCache.insert(fitness.hash, fitness.makespan);
+    }
 }
 
-// Mutate a solution
-void mutate(Solution& solution) {
-    if ((double)(rng() % 100) / 100.0 < MUTATION_RATE) {
-        int index1 = rng() % numTasks;
-        int index2 = rng() % numTasks;
-        swap(solution.schedule[index1], solution.schedule[index2]);
-        solution.makespan = calculateMakespan(solution.schedule);
+// Size the scratch space of a breeding thread or island
+void initWorkspace(BreedingWorkspace& workspace) {
+    workspace.evaluator.init(instance);
+    if (BATCH_EVALUATION) {
+        workspace.batch.init(instance);
     }
+    workspace.taken.assign(numJobs, 0);
+    workspace.stats = EvaluationStats();
+}
+
+// Selection, crossover and mutation of one offspring pair into the back
+// buffer; with BATCH_EVALUATION, offspring that need decoding stay dirty
+void breedPair(PopulationArena& population, int pair, Random& random, BreedingWorkspace& workspace) {
+    int child = 2 * pair;
+    int parent1 = tournamentSelection(population, random);
+    int parent2 = tournamentSelection(population, random);
+
+    crossover(population, parent1, parent2, child, random, workspace);
+
+    for (int c = child; c < child + 2; ++c) {
+        mutate(population.offspringSchedule(c), population.offspringFitness(c), random);
+        if (BATCH_EVALUATION) {
+            resolveOffspring(population.offspringFitness(c), workspace);
+        } else {
+            evaluateOffspring(population.offspringSchedule(c), population.offspringFitness(c), workspace);
+        }
+    }
+}
+
+// Copy the best member of the population into best if it improves on it
+bool updateBest(const PopulationArena& population, Solution& best) {
+    bool improved = false;
+    for (int i = 0; i < population.size(); ++i) {
+        if (population.makespan(i) < best.makespan) {
+            best.schedule.assign(population.schedule(i), population.schedule(i) + numTasks);
+            best.makespan = population.makespan(i);
+            improved = true;
+        }
+    }
+    return improved;
 }
 
 // Main Genetic Algorithm function
 Solution geneticAlgorithm() {
     // Step 1: Initialize population
-    vector<Solution> population;
-    for (int i = 0; i < POPULATION_SIZE; ++i) {
-        population.push_back(generateInitialSolution());
-    }
+    PopulationArena population;
+    initPopulation(population, POPULATION_SIZE);
 
-    Solution bestSolution = population[0];
+    Solution bestSolution;
+    bestSolution.makespan = INT_MAX;
+    updateBest(population, bestSolution);
+
+    ThreadPool pool(NUM_THREADS);
+    int numPairs = (POPULATION_SIZE + 1) / 2;
+    vector<int> pending;
 
     // Step 2: Evolution loop
     for (int generation = 0; generation < MAX_GENERATIONS; ++generation) {
-        vector<Solution> newPopulation;
+        uint64_t generationSeed = rng();
+
+        // Step 3: Selection, crossover, mutation into the back buffer. Pairs
+        // only read the current population and write their own two slots.
+        pool.parallelFor(numPairs, PAIRS_PER_CHUNK, [&](int begin, int end, int thread) {
+            BreedingWorkspace& workspace = workspaces[thread];
+            for (int pair = begin; pair < end; ++pair) {
+                Random random(generationSeed, pair);
+                breedPair(population, pair, random, workspace);
+            }
+        });
+
+        // Step 3b: Decode the remaining offspring, one SIMD batch per task
+        if (BATCH_EVALUATION) {
+            collectPending(population, numPairs, pending);
+            int numBatches = ((int)pending.size() + BatchEvaluator::LANES - 1) / BatchEvaluator::LANES;
+            pool.parallelFor(numBatches, 1, [&](int begin, int end, int thread) {
+                for (int b = begin; b < end; ++b) {
+                    int first = b * BatchEvaluator::LANES;
+                    int last = min((int)pending.size(), first + BatchEvaluator::LANES);
+                    decodePending(population, pending, first, last, workspaces[thread]);
+                }
+            });
+        }
 
-        // Step 3: Selection, crossover, mutation
-        while (newPopulation.size() < POPULATION_SIZE) {
-            Solution parent1 = tournamentSelection(population);
-            Solution parent2 = tournamentSelection(population);
+        // Step 4: Replace population with new population
+        population.swapBuffers();
+
+        // Step 5: Update best solution
+        updateBest(population, bestSolution);
+    }
+
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        evaluationStats.add(workspaces[t].stats);
+    }
+    return bestSolution;
+}
 
-            pair<Solution, Solution> offspring = crossover(parent1, parent2);
+// One island of the island model, owned by a single thread
+struct Island {
+    PopulationArena population;
+    BreedingWorkspace workspace;
+    Solution best;
+    vector<int> ranking;         // Member indices, partially sorted for migration
+    int lastImprovement;         // Generation of the last new island best
+    long long migrantsReceived;
+};
 
-            mutate(offspring.first);
-            mutate(offspring.second);
+// Mailbox carrying migrants from island `from` to island `to`
+ScheduleMailbox& mailbox(vector<ScheduleMailbox>& mailboxes, int to, int from) {
+    return mailboxes[to * NUM_ISLANDS + from];
+}
 
-            newPopulation.push_back(offspring.first);
-            newPopulation.push_back(offspring.second);
+// Post the island's best members to its neighbors in the migration topology
+void sendMigrants(Island& island, int id, vector<ScheduleMailbox>& mailboxes, Random& random) {
+    vector<int>& ranking = island.ranking;
+    const PopulationArena& population = island.population;
+    partial_sort(ranking.begin(), ranking.begin() + MIGRATION_SIZE, ranking.end(),
+                 [&](int a, int b) { return population.makespan(a) < population.makespan(b); });
+
+    // One neighbour per migration for the random topology, drawn once
+    int randomTarget = TOPOLOGY == RANDOM_NEIGHBOR ? (id + 1 + random.below(NUM_ISLANDS - 1)) % NUM_ISLANDS : -1;
+    for (int to = 0; to < NUM_ISLANDS; ++to) {
+        bool neighbor;
+        if (TOPOLOGY == RING) {
+            neighbor = to == (id + 1) % NUM_ISLANDS;
+        } else if (TOPOLOGY == FULLY_CONNECTED) {
+            neighbor = to != id;
+        } else {
+            neighbor = to == randomTarget;
+        }
+        ScheduleMailbox& box = mailbox(mailboxes, to, id);
+        if (!neighbor || !box.beginPost()) {
+            continue;
         }
+        for (int m = 0; m < MIGRATION_SIZE; ++m) {
+            copy(population.schedule(ranking[m]), population.schedule(ranking[m]) + numTasks, box.schedule(m));
+            box.makespan(m) = population.makespan(ranking[m]);
+        }
+        box.endPost(MIGRATION_SIZE);
+    }
+}
 
-        // Step 4: Replace population with new population
-        population = newPopulation;
+// Replace the island's worst members with any migrants waiting in its mailboxes
+void receiveMigrants(Island& island, int id, vector<ScheduleMailbox>& mailboxes) {
+    vector<int>& ranking = island.ranking;
+    PopulationArena& population = island.population;
+    for (int from = 0; from < NUM_ISLANDS; ++from) {
+        ScheduleMailbox& box = mailbox(mailboxes, id, from);
+        if (from == id || !box.beginCollect()) {
+            continue;
+        }
+        partial_sort(ranking.begin(), ranking.begin() + box.count(), ranking.end(),
+                     [&](int a, int b) { return population.makespan(a) > population.makespan(b); });
+        for (int m = 0; m < box.count(); ++m) {
+            int* schedule = population.schedule(ranking[m]);
+            copy(box.schedule(m), box.schedule(m) + numTasks, schedule);
+            Fitness& fitness = population.fitness(ranking[m]);
+            fitness.makespan = box.makespan(m);
+            fitness.dirty = false;
+            fitness.hash = zobrist.hash(schedule, numTasks);
+        }
+        island.migrantsReceived += box.count();
+        box.endCollect();
+    }
+}
 
-        // Step 5: Update best solution
-        for (size_t i = 0; i < population.size(); ++i) {
-            const Solution& sol = population[i];
-            if (sol.makespan < bestSolution.makespan) {
-                bestSolution = sol;
+// Evolve one island for MAX_GENERATIONS, migrating without ever waiting on other islands
+void evolveIsland(Island& island, int id, vector<ScheduleMailbox>& mailboxes, uint64_t seed) {
+    Random random(seed, id);
+    int numPairs = (ISLAND_SIZE + 1) / 2;
+    vector<int> pending;
+    for (int generation = 0; generation < MAX_GENERATIONS; ++generation) {
+        for (int pair = 0; pair < numPairs; ++pair) {
+            breedPair(island.population, pair, random, island.workspace);
+        }
+        if (BATCH_EVALUATION) {
+            collectPending(island.population, numPairs, pending);
+            for (int first = 0; first < (int)pending.size(); first += BatchEvaluator::LANES) {
+                int last = min((int)pending.size(), first + BatchEvaluator::LANES);
+                decodePending(island.population, pending, first, last, island.workspace);
             }
         }
+        island.population.swapBuffers();
+
+        receiveMigrants(island, id, mailboxes);
+        if (updateBest(island.population, island.best)) {
+            island.lastImprovement = generation;
+        }
+        if ((generation + 1) % MIGRATION_INTERVAL == 0) {
+            sendMigrants(island, id, mailboxes, random);
+        }
     }
+}
 
+// Island model GA: one thread per island, then per-island convergence statistics
+Solution islandModel() {
+    vector<Island> islands(NUM_ISLANDS);
+    vector<ScheduleMailbox> mailboxes(NUM_ISLANDS * NUM_ISLANDS);
+    for (size_t b = 0; b < mailboxes.size(); ++b) {
+        mailboxes[b].init(MIGRATION_SIZE, numTasks);
+    }
+    for (int id = 0; id < NUM_ISLANDS; ++id) {
+        Island& island = islands[id];
+        initPopulation(island.population, ISLAND_SIZE);
+        initWorkspace(island.workspace);
+        island.ranking.resize(ISLAND_SIZE);
+        for (int i = 0; i < ISLAND_SIZE; ++i) {
+            island.ranking[i] = i;
+        }
+        island.best.makespan = INT_MAX;
+        updateBest(island.population, island.best);
+        island.lastImprovement = 0;
+        island.migrantsReceived = 0;
+    }
+
+    uint64_t seed = rng();
+    vector<thread> threads;
+    for (int id = 0; id < NUM_ISLANDS; ++id) {
+        threads.push_back(thread(evolveIsland, ref(islands[id]), id, ref(mailboxes), seed));
+    }
+    for (int id = 0; id < NUM_ISLANDS; ++id) {
+        threads[id].join();
+    }
+
+    Solution bestSolution = islands[0].best;
+    for (int id = 0; id < NUM_ISLANDS; ++id) {
+        const Island& island = islands[id];
+        const PopulationArena& population = island.population;
+        double mean = 0, variance = 0;
+        for (int i = 0; i < ISLAND_SIZE; ++i) {
+            mean += population.makespan(i);
+        }
+        mean /= ISLAND_SIZE;
+        for (int i = 0; i < ISLAND_SIZE; ++i) {
+            variance += (population.makespan(i) - mean) * (population.makespan(i) - mean);
+        }
+        cout << "Island " << id << ": best " << island.best.makespan
+             << "  mean " << mean << "  stddev " << sqrt(variance / ISLAND_SIZE)
+             << "  last improvement " << island.lastImprovement
+             << "  migrants received " << island.migrantsReceived << endl;
+        if (island.best.makespan < bestSolution.makespan) {
+            bestSolution = island.best;
+        }
+        evaluationStats.add(island.workspace.stats);
+    }
     return bestSolution;
 }
 
-int main() {
-    // Initialize jobs data manually
-    jobs.resize(3);
-    Task task1 = {0, 0, 3};
-    Task task2 = {0, 1, 2};
-    Task task3 = {0, 2, 2};
-    jobs[0].push_back(task1);
-    jobs[0].push_back(task2);
-    jobs[0].push_back(task3);
-
-    Task task4 = {1, 0, 2};
-    Task task5 = {1, 1, 1};
-    Task task6 = {1, 2, 4};
-    jobs[1].push_back(task4);
-    jobs[1].push_back(task5);
-    jobs[1].push_back(task6);
-
-    Task task7 = {2, 0, 4};
-    Task task8 = {2, 1, 3};
-    Task task9 = {2, 2, 3};
-    jobs[2].push_back(task7);
-    jobs[2].push_back(task8);
-    jobs[2].push_back(task9);
-
-    numJobs = jobs.size();
-    numTasks = numJobs * numMachines;
-
-    // Run Genetic Algorithm
-    clock_t start = clock();
-    Solution bestSolution = geneticAlgorithm();
-    clock_t end = clock();
-
-    double duration = (double)(end - start) / CLOCKS_PER_SEC * 1000;
-    cout << "Best makespan: " << bestSolution.makespan << endl;
-    cout << "Execution time: " << duration << " ms" << endl;
+// Schedules/sec of one-at-a-time decoding and of the batch evaluator on every
+// kernel this CPU supports, all on the same random schedules
+void reportBatchThroughput() {
+    const int count = 4096;
+    const int repeats = 20;
+    Random random;
+    vector<int> genes((size_t)count * numTasks);
+    vector<const int*> schedules(count);
+    vector<int> sequence;
+    initialSequence(instance, sequence);
+    for (int k = 0; k < count; ++k) {
+        shuffle(sequence.begin(), sequence.end(), random);
+        copy(sequence.begin(), sequence.end(), &genes[(size_t)k * numTasks]);
+        schedules[k] = &genes[(size_t)k * numTasks];
+    }
+
+    vector<int> expected(count), makespans(count);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (int k = 0; k < count; ++k) {
+            expected[k] = evaluator.makespan(schedules[k], numTasks);
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double baseline = (double)count * repeats / seconds;
+    cout << "Schedules/sec (one at a time): " << baseline << endl;
+
+    for (int level = SIMD_SCALAR; level <= detectSimdLevel(); ++level) {
+        BatchEvaluator batch;
+        batch.init(instance, (SimdLevel)level);
+        start = chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            batch.evaluate(schedules.data(), count, makespans.data());
+        }
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        double rate = (double)count * repeats / seconds;
+        cout << "Schedules/sec (batch, " << simdLevelName((SimdLevel)level) << "): " << rate
+             << "  speedup: " << rate / baseline << "x"
+             << (makespans == expected ? "" : "  MISMATCH") << endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    uint64_t masterSeed = parseSeed(argc, argv);
+    cout << "Seed: " << masterSeed << endl;
+
+    vector<NamedInstance> instances;
+    if (!loadCommandLineInstances(argc, argv, instances)) {
+        return 1;
+    }
+
+    // Every instance starts from the master seed, so its result does not
+    // depend on the instances before it
+    for (size_t k = 0; k < instances.size(); ++k) {
+        instance = move(instances[k].instance);
+        cout << "Instance: " << instances[k].name << " (" << instance.numJobs << "x"
+             << instance.numMachines << ")" << endl;
+        rng.seed(masterSeed);
+        evaluator.init(instance);
+        numJobs = instance.numJobs;
+        numTasks = instance.numOps;
+        workspaces.resize(NUM_THREADS);
+        for (int t = 0; t < NUM_THREADS; ++t) {
+            initWorkspace(workspaces[t]);
+        }
+        zobrist.init(numTasks, numJobs);
+        fitnessCache.init(FITNESS_CACHE_LOG2);
+        evaluationStats = EvaluationStats();
+
+        if (REPORT_BATCH_THROUGHPUT) {
+            reportBatchThroughput();
+        }
+
+        // Run Genetic Algorithm (wall-clock time, as it may use several threads)
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        Solution bestSolution = ISLAND_MODEL ? islandModel() : geneticAlgorithm();
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+        double duration = chrono::duration<double, milli>(end - start).count();
+        long long changed = evaluationStats.evaluations + evaluationStats.cacheHits;
+        cout << "Best makespan: " << bestSolution.makespan << endl;
+        cout << "Fitness evaluations: " << evaluationStats.evaluations << endl;
+        cout << "Cache hit rate: " << (changed > 0 ? 100.0 * evaluationStats.cacheHits / changed : 0) << "%" << endl;
+        cout << "Evaluations saved: " << evaluationStats.cacheHits + evaluationStats.unchanged << endl;
+        cout << "Execution time: " << duration << " ms" << endl;
+    }
 
     return 0;
 }
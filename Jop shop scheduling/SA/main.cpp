@@ -2,23 +2,47 @@
 #include <vector>
 #include <algorithm>
 #include <cstdlib>
-#include <ctime>
 #include <cmath>
-#include <random>
+#include <climits>
+#include <chrono>
+#include <thread>
+
+#include "jssp.h"
+#include "incremental_evaluator.h"
+#include "thread_pool.h"
+#include "lockstep_evaluator.h"
+#include "random.h"
+#include "instance_loader.h"
 
 using namespace std;
 
-// Parameters for Simulated Annealing
-const double INITIAL_TEMPERATURE = 10000;
-const double COOLING_RATE = 0.995;
-const int MAX_ITERATIONS = 1000;
+// Parameters for Simulated Annealing. Temperatures are calibrated from
+// sampled move deltas and the cooling rate is derived from the time budget.
+const double DEFAULT_TIME_BUDGET_MS = 100; // Wall-clock time per run unless --time-budget is given
+const int CALIBRATION_SAMPLES = 200;       // Random moves sampled from the initial solution
+const double INITIAL_ACCEPTANCE = 0.5;     // Chance to accept an average worsening move at the start
+const double FINAL_ACCEPTANCE = 0.001;     // Chance to accept the smallest worsening move at the end
+const bool REHEAT_ON_STAGNATION = false;
+const int STAGNATION_LEVELS = 100;         // Temperature levels without improvement before reheating
+const double REHEAT_FRACTION = 0.5;        // Reheat to this fraction of the initial temperature
 
-// Structure for a Task (task on a specific machine with a specific duration)
-struct Task {
-    int jobID;
-    int machineID;
-    int duration;
-};
+// Parallel tempering: NUM_REPLICAS chains at fixed temperatures spread
+// geometrically between the calibrated final and initial temperatures.
+// Neighboring rungs attempt an exchange after every EXCHANGE_INTERVAL moves
+// per replica. One replica per core, but never fewer than MIN_REPLICAS:
+// with too few rungs, neighbors are too far apart in temperature to ever
+// swap. The thread pool splits the rungs across the cores.
+const bool PARALLEL_TEMPERING = false;
+const int MIN_REPLICAS = 8;
+const int EXCHANGE_INTERVAL = 100;
+const int NUM_THREADS = max(1, (int)thread::hardware_concurrency());
+const int NUM_REPLICAS = max(MIN_REPLICAS, NUM_THREADS);
+
+// Many-chain annealing: LockstepEvaluator::LANES independent chains on a
+// shared cooling schedule, all evaluated together with the widest SIMD
+// kernel the CPU supports
+const bool MANY_CHAINS = false;
+const bool REPORT_SIMD_SPEEDUP = false;    // Also run the scalar kernel and compare chain-steps/sec
 
 // Structure to represent a solution (schedule)
 struct Solution {
@@ -26,130 +50,414 @@ struct Solution {
     int makespan;
 };
 
-// Random number generator (using std::mt19937)
-random_device rd;
-mt19937 rng(rd());
+// Master seed (--seed) and its stream 0; every chain owns a stream of its own
+uint64_t masterSeed;
+Random rng;
 
-// Example Job-Shop Scheduling problem data
-vector<vector<Task> > jobs;  // Space added between consecutive right angle brackets
+// Wall-clock milliseconds per run (--time-budget)
+double timeBudgetMs = DEFAULT_TIME_BUDGET_MS;
 
-// Number of jobs and machines
-int numJobs;
-int numMachines = 3;  // Assume 3 machines
+// Flat instance layout and shared evaluator
+Instance instance;
+Evaluator evaluator;
 
 // Calculate the makespan of a schedule
 int calculateMakespan(const vector<int>& schedule) {
-    vector<int> machineTime(numMachines, 0);
-    vector<int> jobTime(numJobs, 0);
-
-    for (size_t i = 0; i < schedule.size(); ++i) {
-        int jobID = schedule[i];
-        for (size_t j = 0; j < jobs[jobID].size(); ++j) {
-            const Task& task = jobs[jobID][j];
-            int machineID = task.machineID;
-            int start = max(machineTime[machineID], jobTime[jobID]);
-            int end = start + task.duration;
-            machineTime[machineID] = end;
-            jobTime[jobID] = end;
-        }
-    }
-    return *max_element(machineTime.begin(), machineTime.end());
+    return evaluator.makespan(schedule);
 }
 
 // Generate a random initial solution
-Solution generateInitialSolution() {
+Solution generateInitialSolution(Random& random) {
     Solution solution;
-    solution.schedule.resize(numJobs * numMachines);
-    for (int j = 0; j < numJobs; ++j) {
-        for (int k = 0; k < numMachines; ++k) {
-            solution.schedule[j * numMachines + k] = j;
-        }
-    }
+    initialSequence(instance, solution.schedule);
     
     // Use std::shuffle instead of random_shuffle
-    shuffle(solution.schedule.begin(), solution.schedule.end(), rng);
+    shuffle(solution.schedule.begin(), solution.schedule.end(), random);
     
     solution.makespan = calculateMakespan(solution.schedule);
     return solution;
 }
 
-// Get a neighboring solution by swapping two jobs in the schedule
-Solution getNeighbor(const Solution& currentSolution) {
-    Solution neighbor = currentSolution;
-    int pos1 = rng() % neighbor.schedule.size();
-    int pos2 = rng() % neighbor.schedule.size();
-    swap(neighbor.schedule[pos1], neighbor.schedule[pos2]);
-    neighbor.makespan = calculateMakespan(neighbor.schedule);
-    return neighbor;
+// One annealing chain: its current solution, prefix snapshots and random stream
+struct Chain {
+    Solution current;
+    IncrementalEvaluator evaluator;
+    Random rng;
+};
+
+// Start a chain on stream `stream` of the master seed, from a random solution
+void initChain(Chain& chain, int stream) {
+    chain.rng.seed(masterSeed, stream);
+    chain.current = generateInitialSolution(chain.rng);
+    chain.evaluator.init(instance);
+    chain.evaluator.rebuild(chain.current.schedule);
+}
+
+// A neighbor move: swap the jobs at two schedule positions
+struct SwapMove {
+    int pos1;
+    int pos2;
+};
+
+// Draw a random swap move
+SwapMove randomMove(Chain& chain) {
+    SwapMove move;
+    move.pos1 = chain.rng.below((int)chain.current.schedule.size());
+    move.pos2 = chain.rng.below((int)chain.current.schedule.size());
+    return move;
+}
+
+// Apply a move in place and return the neighbor's makespan; the chain's
+// makespan keeps the old value until acceptMove. Decoding stops once the
+// makespan is known to exceed cutoff, in which case only a value above
+// cutoff is returned.
+int applyMove(Chain& chain, const SwapMove& move, int cutoff) {
+    swap(chain.current.schedule[move.pos1], chain.current.schedule[move.pos2]);
+    return chain.evaluator.evaluate(chain.current.schedule.data(), min(move.pos1, move.pos2), cutoff);
+}
+
+// Take back a rejected move
+void undoMove(Chain& chain, const SwapMove& move) {
+    swap(chain.current.schedule[move.pos1], chain.current.schedule[move.pos2]);
+}
+
+// Keep an applied move and refresh the evaluator snapshots
+void acceptMove(Chain& chain, const SwapMove& move, int makespan) {
+    chain.current.makespan = makespan;
+    chain.evaluator.commit(chain.current.schedule.data(), min(move.pos1, move.pos2));
+}
+
+// Largest neighbor makespan that passes the Metropolis test for a random
+// draw made in advance: exp((oldCost - newCost) / temperature) > random
+// holds exactly when newCost < oldCost - temperature * ln(random)
+int acceptanceCutoff(int oldCost, double temperature, double random) {
+    if (random <= 0.0) {
+        return INT_MAX;
+    }
+    double limit = oldCost - temperature * log(random);
+    if (limit >= INT_MAX) {
+        return INT_MAX;
+    }
+    return (int)ceil(limit) - 1;
 }
 
-// Calculate the acceptance probability
-double acceptanceProbability(int oldCost, int newCost, double temperature) {
-    if (newCost < oldCost) {
-        return 1.0;
+// One Metropolis step at the given temperature; returns true if it improved best
+bool metropolisStep(Chain& chain, double temperature, Solution& best) {
+    // Draw the acceptance threshold first so the evaluation can abort early
+    double random = chain.rng.unit();
+    int cutoff = acceptanceCutoff(chain.current.makespan, temperature, random);
+
+    SwapMove move = randomMove(chain);
+    int neighborMakespan = applyMove(chain, move, cutoff);
+
+    if (neighborMakespan > cutoff) {
+        undoMove(chain, move);
+        return false;
+    }
+    acceptMove(chain, move, neighborMakespan);
+
+    // Snapshot the best solution only when it improves (no reallocation)
+    if (chain.current.makespan < best.makespan) {
+        best.schedule = chain.current.schedule;
+        best.makespan = chain.current.makespan;
+        return true;
+    }
+    return false;
+}
+
+// Set the initial and final temperatures from the worsening deltas of random moves
+void calibrateTemperatures(Chain& chain, double& initialTemperature, double& finalTemperature) {
+    double sumDelta = 0;
+    int worsening = 0;
+    int minDelta = INT_MAX;
+    for (int i = 0; i < CALIBRATION_SAMPLES; ++i) {
+        SwapMove move = randomMove(chain);
+        int delta = applyMove(chain, move, INT_MAX) - chain.current.makespan;
+        undoMove(chain, move);
+        if (delta > 0) {
+            sumDelta += delta;
+            minDelta = min(minDelta, delta);
+            ++worsening;
+        }
+    }
+    if (worsening == 0) {
+        sumDelta = 1;
+        minDelta = 1;
+        worsening = 1;
     }
-    return exp((oldCost - newCost) / temperature);
+    initialTemperature = -(sumDelta / worsening) / log(INITIAL_ACCEPTANCE);
+    finalTemperature = min(initialTemperature, -minDelta / log(FINAL_ACCEPTANCE));
+}
+
+// Cool so that the final temperature is reached when the time budget runs out,
+// given the average time per level so far
+double nextTemperature(double temperature, double finalTemperature, double elapsed, int levels) {
+    double msPerLevel = elapsed / levels;
+    double remainingLevels = max(1.0, (timeBudgetMs - elapsed) / msPerLevel);
+    double coolingRate = pow(finalTemperature / temperature, 1.0 / remainingLevels);
+    return max(finalTemperature, temperature * min(1.0, coolingRate));
+}
+
+// Time budget from "--time-budget MS" or "--time-budget=MS", else the default
+double parseTimeBudget(int argc, char** argv) {
+    const char* value = optionValue(argc, argv, "--time-budget");
+    if (!value) {
+        return DEFAULT_TIME_BUDGET_MS;
+    }
+    char* end = 0;
+    double budget = strtod(value, &end);
+    if (*value == '\0' || *end != '\0' || !(budget > 0)) {
+        cerr << "Invalid time budget: " << value << endl;
+        exit(1);
+    }
+    return budget;
 }
 
 // Main Simulated Annealing function
 Solution simulatedAnnealing() {
-    Solution currentSolution = generateInitialSolution();
-    Solution bestSolution = currentSolution;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Chain chain;
+    initChain(chain, 1);
+    Solution bestSolution = chain.current;
 
-    double temperature = INITIAL_TEMPERATURE;
+    double initialTemperature, finalTemperature;
+    calibrateTemperatures(chain, initialTemperature, finalTemperature);
+    double temperature = initialTemperature;
 
-    // Simulated Annealing loop
-    for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
-        Solution neighbor = getNeighbor(currentSolution);
+    // One Markov chain of chainLength moves per temperature level
+    int chainLength = (int)chain.current.schedule.size();
+    int stagnantLevels = 0;
+    int levels = 0;
 
-        if (acceptanceProbability(currentSolution.makespan, neighbor.makespan, temperature) > ((double) rng() / rng.max())) {
-            currentSolution = neighbor;
+    // Simulated Annealing loop (moves are applied in place and undone on rejection)
+    for (;;) {
+        bool improved = false;
+        for (int step = 0; step < chainLength; ++step) {
+            if (metropolisStep(chain, temperature, bestSolution)) {
+                improved = true;
+            }
         }
 
-        if (currentSolution.makespan < bestSolution.makespan) {
-            bestSolution = currentSolution;
+        // Spread the remaining temperature range over the levels that still fit in the budget
+        double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (elapsed >= timeBudgetMs) {
+            break;
         }
+        temperature = nextTemperature(temperature, finalTemperature, elapsed, ++levels);
 
-        temperature *= COOLING_RATE;
+        stagnantLevels = improved ? 0 : stagnantLevels + 1;
+        if (REHEAT_ON_STAGNATION && stagnantLevels >= STAGNATION_LEVELS) {
+            temperature = max(temperature, initialTemperature * REHEAT_FRACTION);
+            stagnantLevels = 0;
+        }
     }
 
     return bestSolution;
 }
 
-int main() {
-    // Initialize jobs data manually
-    jobs.resize(3);
-    Task task1 = {0, 0, 3};
-    Task task2 = {0, 1, 2};
-    Task task3 = {0, 2, 2};
-    jobs[0].push_back(task1);
-    jobs[0].push_back(task2);
-    jobs[0].push_back(task3);
-
-    Task task4 = {1, 0, 2};
-    Task task5 = {1, 1, 1};
-    Task task6 = {1, 2, 4};
-    jobs[1].push_back(task4);
-    jobs[1].push_back(task5);
-    jobs[1].push_back(task6);
-
-    Task task7 = {2, 0, 4};
-    Task task8 = {2, 1, 3};
-    Task task9 = {2, 2, 3};
-    jobs[2].push_back(task7);
-    jobs[2].push_back(task8);
-    jobs[2].push_back(task9);
-
-    numJobs = jobs.size();
-
-    // Run Simulated Annealing
-    clock_t start = clock();
-    Solution bestSolution = simulatedAnnealing();
-    clock_t end = clock();
-
-    double duration = (double)(end - start) / CLOCKS_PER_SEC * 1000;
-    cout << "Best makespan: " << bestSolution.makespan << endl;
-    cout << "Execution time: " << duration << " ms" << endl;
+// One parallel tempering replica and the best solution it has seen
+struct Replica {
+    Chain chain;
+    Solution best;
+    long long moves;
+};
+
+// Parallel tempering: replicas sweep concurrently, each on its own random
+// stream and evaluator, then neighboring rungs exchange temperatures with
+// probability min(1, exp((1/T_k - 1/T_k+1) * (E_k - E_k+1))). Exchanges only
+// permute the rung -> replica map and are decided serially after each sweep,
+// so threads never wait on each other inside a sweep. Every replica checks
+// the deadline as it sweeps, so the run ends on time whatever the instance size.
+Solution parallelTempering() {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    chrono::steady_clock::time_point deadline =
+        start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double, milli>(timeBudgetMs));
+    vector<Replica> replicas(NUM_REPLICAS);
+    for (int r = 0; r < NUM_REPLICAS; ++r) {
+        initChain(replicas[r].chain, r + 1);
+        replicas[r].best = replicas[r].chain.current;
+        replicas[r].moves = 0;
+    }
+
+    double initialTemperature, finalTemperature;
+    calibrateTemperatures(replicas[0].chain, initialTemperature, finalTemperature);
+    vector<double> ladder(NUM_REPLICAS);
+    vector<int> replicaAt(NUM_REPLICAS);  // Replica currently at each rung
+    for (int k = 0; k < NUM_REPLICAS; ++k) {
+        ladder[k] = finalTemperature * pow(initialTemperature / finalTemperature, (double)k / (NUM_REPLICAS - 1));
+        replicaAt[k] = k;
+    }
+
+    ThreadPool pool(NUM_THREADS);
+    long long attempts = 0, exchanges = 0;
+
+    for (int round = 0; ; ++round) {
+        pool.parallelFor(NUM_REPLICAS, 1, [&](int begin, int end, int) {
+            for (int k = begin; k < end; ++k) {
+                Replica& replica = replicas[replicaAt[k]];
+                for (int step = 0; step < EXCHANGE_INTERVAL; ++step) {
+                    if (step % 8 == 0 && chrono::steady_clock::now() >= deadline) {
+                        break;
+                    }
+                    metropolisStep(replica.chain, ladder[k], replica.best);
+                    ++replica.moves;
+                }
+            }
+        });
+
+        if (chrono::steady_clock::now() >= deadline) {
+            double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            long long moves = 0;
+            for (int r = 0; r < NUM_REPLICAS; ++r) {
+                moves += replicas[r].moves;
+            }
+            cout << "Replica exchanges: " << exchanges << " / " << attempts << endl;
+            cout << "Moves per second: " << moves / (elapsed / 1000) << endl;
+            break;
+        }
+
+        // Attempt exchanges between rungs (k, k + 1), alternating even and odd pairs
+        for (int k = round % 2; k + 1 < NUM_REPLICAS; k += 2) {
+            int cold = replicas[replicaAt[k]].chain.current.makespan;
+            int hot = replicas[replicaAt[k + 1]].chain.current.makespan;
+            double exponent = (1.0 / ladder[k] - 1.0 / ladder[k + 1]) * (cold - hot);
+            ++attempts;
+            if (exponent >= 0 || rng.unit() < exp(exponent)) {
+                swap(replicaAt[k], replicaAt[k + 1]);
+                ++exchanges;
+            }
+        }
+    }
+
+    Solution bestSolution = replicas[0].best;
+    for (int r = 1; r < NUM_REPLICAS; ++r) {
+        if (replicas[r].best.makespan < bestSolution.makespan) {
+            bestSolution = replicas[r].best;
+        }
+    }
+    return bestSolution;
+}
+
+// Many-chain annealing: each step proposes one swap per chain in the
+// structure-of-arrays schedules, evaluates all chains at once and undoes the
+// swaps of the lanes outside the returned acceptance mask
+Solution manyChainAnnealing(SimdLevel level, double& chainStepsPerSecond) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    const int lanes = LockstepEvaluator::LANES;
+    LockstepEvaluator lockstep;
+    lockstep.init(instance, level);
+
+    Chain chain;
+    initChain(chain, 1);
+    Solution bestSolution = chain.current;
+    double initialTemperature, finalTemperature;
+    calibrateTemperatures(chain, initialTemperature, finalTemperature);
+    double temperature = initialTemperature;
+
+    int length = instance.numOps;
+    vector<int> schedules((size_t)length * lanes);
+    vector<int> current(lanes), cutoffs(lanes), makespans(lanes), pos1(lanes), pos2(lanes);
+    vector<double> randoms(lanes);
+    for (int l = 0; l < lanes; ++l) {
+        Solution initial = generateInitialSolution(chain.rng);
+        for (int i = 0; i < length; ++i) {
+            schedules[i * lanes + l] = initial.schedule[i];
+        }
+        current[l] = initial.makespan;
+    }
+
+    long long steps = 0;
+    for (int levels = 1; ; ++levels) {
+        for (int step = 0; step < length; ++step) {
+            chain.rng.units(randoms.data(), lanes);
+            for (int l = 0; l < lanes; ++l) {
+                pos1[l] = chain.rng.below(length);
+                pos2[l] = chain.rng.below(length);
+                swap(schedules[pos1[l] * lanes + l], schedules[pos2[l] * lanes + l]);
+                cutoffs[l] = acceptanceCutoff(current[l], temperature, randoms[l]);
+            }
+
+            unsigned accepted = lockstep.evaluate(schedules.data(), cutoffs.data(), makespans.data());
+
+            for (int l = 0; l < lanes; ++l) {
+                if (!(accepted >> l & 1)) {
+                    swap(schedules[pos1[l] * lanes + l], schedules[pos2[l] * lanes + l]);
+                    continue;
+                }
+                current[l] = makespans[l];
+                if (current[l] < bestSolution.makespan) {
+                    for (int i = 0; i < length; ++i) {
+                        bestSolution.schedule[i] = schedules[i * lanes + l];
+                    }
+                    bestSolution.makespan = current[l];
+                }
+            }
+        }
+        steps += (long long)length * lanes;
+
+        double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (elapsed >= timeBudgetMs) {
+            chainStepsPerSecond = steps / (elapsed / 1000);
+            break;
+        }
+        temperature = nextTemperature(temperature, finalTemperature, elapsed, levels);
+    }
+
+    return bestSolution;
+}
+
+// Compare chain-steps/sec of the scalar and SIMD kernels on the same budget
+void reportSimdSpeedup() {
+    SimdLevel level = detectSimdLevel();
+    double scalarRate, simdRate;
+    Solution scalarResult = manyChainAnnealing(SIMD_SCALAR, scalarRate);
+    Solution simdResult = manyChainAnnealing(level, simdRate);
+    cout << "Chain-steps/sec (scalar): " << scalarRate << "  best makespan: " << scalarResult.makespan << endl;
+    cout << "Chain-steps/sec (" << simdLevelName(level) << "): " << simdRate
+         << "  best makespan: " << simdResult.makespan << endl;
+    cout << "SIMD speedup: " << simdRate / scalarRate << "x" << endl;
+}
+
+int main(int argc, char** argv) {
+    masterSeed = parseSeed(argc, argv);
+    timeBudgetMs = parseTimeBudget(argc, argv);
+    cout << "Seed: " << masterSeed << endl;
+    cout << "Time budget: " << timeBudgetMs << " ms" << endl;
+
+    vector<NamedInstance> instances;
+    if (!loadCommandLineInstances(argc, argv, instances)) {
+        return 1;
+    }
+
+    // Every instance starts from the master seed, so its result does not
+    // depend on the instances before it
+    for (size_t k = 0; k < instances.size(); ++k) {
+        instance = move(instances[k].instance);
+        cout << "Instance: " << instances[k].name << " (" << instance.numJobs << "x"
+             << instance.numMachines << ")" << endl;
+        rng.seed(masterSeed);
+        evaluator.init(instance);
+
+        if (MANY_CHAINS && REPORT_SIMD_SPEEDUP) {
+            reportSimdSpeedup();
+        }
+
+        // Run Simulated Annealing (wall-clock time, as the run may use several threads)
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        Solution bestSolution;
+        if (MANY_CHAINS) {
+            double chainStepsPerSecond;
+            bestSolution = manyChainAnnealing(detectSimdLevel(), chainStepsPerSecond);
+            cout << "Chain-steps/sec (" << simdLevelName(detectSimdLevel()) << "): " << chainStepsPerSecond << endl;
+        } else {
+            bestSolution = PARALLEL_TEMPERING ? parallelTempering() : simulatedAnnealing();
+        }
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+        double duration = chrono::duration<double, milli>(end - start).count();
+        cout << "Best makespan: " << bestSolution.makespan << endl;
+        cout << "Execution time: " << duration << " ms" << endl;
+    }
 
     return 0;
 }
@@ -1,22 +1,40 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>  // For std::shuffle
-#include <queue>
-#include <ctime>      // For srand() and time()
-#include <random>     // For default_random_engine
+#include <thread>
+#include <chrono>
+
+#include "jssp.h"
+#include "incremental_evaluator.h"
+#include "disjunctive_graph.h"
+#include "thread_pool.h"
+#include "zobrist.h"
+#include "random.h"
+#include "instance_loader.h"
 
 using namespace std;
 
 // Constants for Tabu Search
 const int TABU_TENURE = 10;
+const int TABU_TENURE_SPREAD = 3;  // Each tenure is drawn from TABU_TENURE +- spread
 const int MAX_ITERATIONS = 1000;
 
-// Structure for a Task (task on a specific machine with a specific duration)
-struct Task {
-    int jobID;
-    int machineID;
-    int duration;
+// Cycle detection: visited fingerprints, and the escape used when every move revisits
+const int VISITED_SET_LOG2 = 16;       // 65536 slots (512 KB)
+const int DIVERSIFICATION_SWAPS = 5;   // Random swaps per diversification
+const int MAX_DIVERSIFICATIONS = 50;   // Stop early after this many
+
+// Neighborhood explored by Tabu Search
+enum NeighborhoodMode {
+    RANDOM_SWAPS,     // numJobs random position swaps, each fully evaluated
+    CRITICAL_BLOCKS,  // Swaps at critical block boundaries, scored by head/tail estimates
+    FULL_SWAPS        // Every position swap, scored in parallel on NUM_THREADS threads
 };
+const NeighborhoodMode NEIGHBORHOOD = CRITICAL_BLOCKS;
+
+// Threads for the FULL_SWAPS neighborhood, and whether to report its scaling from 1 thread up
+const int NUM_THREADS = max(1, (int)thread::hardware_concurrency());
+const bool REPORT_THREAD_SCALING = false;
 
 // Structure to represent a solution (schedule)
 struct Solution {
@@ -24,106 +42,443 @@ struct Solution {
     int makespan;
 };
 
-// Random number generation with pre-C++11 method (rand)
-void initializeRandom() {
-    srand(static_cast<unsigned int>(time(0)));
-}
+// Master seed (--seed) and the search's random stream
+uint64_t masterSeed;
+Random rng;
+
+// Flat instance layout and shared evaluator
+Instance instance;
+Evaluator evaluator;
+IncrementalEvaluator incrementalEvaluator;  // Snapshots of the current solution
+DisjunctiveGraph graph;                     // Critical-path view of the current solution
 
-// Example Job-Shop Scheduling problem data
-vector<vector<Task> > jobs;  // Added space between right angle brackets
+// Number of schedules evaluated exactly during the search
+long long fullEvaluations = 0;
 
-// Number of jobs and machines
+// Fingerprints of the solutions visited by the search
+ZobristTable zobrist;
+VisitedSet visited;
+long long revisitsAvoided = 0;
+int diversifications = 0;
+
+// Number of jobs
 int numJobs;
-const int NUM_MACHINES = 3;  // Assume 3 machines
 
 // Calculate the makespan of a schedule
 int calculateMakespan(const vector<int>& schedule) {
-    vector<int> machineTime(NUM_MACHINES, 0);
-    vector<int> jobTime(numJobs, 0);
-
-    for (size_t i = 0; i < schedule.size(); ++i) {
-        int jobID = schedule[i];
-        for (size_t j = 0; j < jobs[jobID].size(); ++j) {
-            const Task& task = jobs[jobID][j];
-            int machineID = task.machineID;
-            int start = max(machineTime[machineID], jobTime[jobID]);
-            int end = start + task.duration;
-            machineTime[machineID] = end;
-            jobTime[jobID] = end;
-        }
-    }
-    return *max_element(machineTime.begin(), machineTime.end());
+    return evaluator.makespan(schedule);
 }
 
 // Generate a random initial solution
 Solution generateInitialSolution() {
     Solution solution;
-    solution.schedule.resize(numJobs * NUM_MACHINES);
-    for (int j = 0; j < numJobs; ++j) {
-        for (int k = 0; k < NUM_MACHINES; ++k) {
-            solution.schedule[j * NUM_MACHINES + k] = j;
-        }
-    }
+    initialSequence(instance, solution.schedule);
 
-    // Use std::shuffle with std::default_random_engine
-    std::default_random_engine rng(static_cast<unsigned>(time(0)));
     shuffle(solution.schedule.begin(), solution.schedule.end(), rng);
 
     solution.makespan = calculateMakespan(solution.schedule);
     return solution;
 }
 
-// Get a neighboring solution by swapping two jobs in the schedule
-Solution getNeighbor(const Solution& currentSolution) {
+// Get a neighboring solution by swapping the jobs at pos1 and pos2
+Solution getNeighbor(const Solution& currentSolution, int pos1, int pos2) {
     Solution neighbor = currentSolution;
-    int pos1 = rand() % neighbor.schedule.size();
-    int pos2 = rand() % neighbor.schedule.size();
     swap(neighbor.schedule[pos1], neighbor.schedule[pos2]);
-    neighbor.makespan = calculateMakespan(neighbor.schedule);
+    neighbor.makespan = incrementalEvaluator.evaluate(neighbor.schedule.data(), min(pos1, pos2));
+    ++fullEvaluations;
     return neighbor;
 }
 
-// Main Tabu Search function
-Solution tabuSearch() {
+// Tabu memory as a flat matrix of "tabu until iteration" stamps, indexed by a
+// move attribute (row = job or operation, col = position it may not return to)
+struct TabuMemory {
+    int cols;
+    vector<int> until;
+
+    void init(int rows, int numCols) {
+        cols = numCols;
+        until.assign((size_t)rows * cols, 0);
+    }
+
+    bool isTabu(int row, int col, int iteration) const {
+        return until[(size_t)row * cols + col] > iteration;
+    }
+
+    void forbid(int row, int col, int untilIteration) {
+        until[(size_t)row * cols + col] = untilIteration;
+    }
+};
+
+// Random tenure around TABU_TENURE
+int drawTenure() {
+    return TABU_TENURE - TABU_TENURE_SPREAD + rng.below(2 * TABU_TENURE_SPREAD + 1);
+}
+
+// Swap a random adjacent pair on the critical path, updating its machine-sequence hash
+bool randomCriticalSwap(uint64_t& hash) {
+    graph.computeCriticalPath();
+    const vector<int>& path = graph.criticalPath();
+    int start = rng.below((int)path.size());
+    for (int k = 0; k + 1 < (int)path.size(); ++k) {
+        int i = (start + k) % ((int)path.size() - 1);
+        int u = path[i];
+        int v = path[i + 1];
+        if (graph.machineSucc(u) == v && graph.jobSucc(u) != v) {
+            int pos = graph.machinePos(u);
+            if (graph.swapAdjacent(u, v)) {
+                hash ^= zobrist.swapDelta(u, pos, v, pos + 1);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Tabu Search over the critical-block neighborhood: only adjacent swaps at the
+// first and last pair of each critical block are considered, each scored by
+// DisjunctiveGraph::estimateSwap, and only the chosen move is applied exactly
+Solution criticalBlockTabuSearch() {
     Solution currentSolution = generateInitialSolution();
     Solution bestSolution = currentSolution;
 
-    queue<pair<int, int> > tabuList;  // Added space between right angle brackets
+    // Attribute: operation x position on its machine
+    int maxMachineLoad = 0;
+    for (int m = 0; m < instance.numMachines; ++m) {
+        maxMachineLoad = max(maxMachineLoad, instance.machineOffset[m + 1] - instance.machineOffset[m]);
+    }
+    TabuMemory tabu;
+    tabu.init(instance.numOps, maxMachineLoad);
+    graph.build(currentSolution.schedule);
+
+    // Fingerprint of the machine sequences: operation x machine position
+    zobrist.init(instance.numOps, maxMachineLoad);
+    visited.init(VISITED_SET_LOG2);
+    uint64_t hash = 0;
+    for (int op = 0; op < instance.numOps; ++op) {
+        hash ^= zobrist.key(op, graph.machinePos(op));
+    }
+    visited.insert(hash);
+
+    // Tabu Search loop
+    for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+        graph.computeCriticalPath();
+        const vector<int>& path = graph.criticalPath();
+
+        int bestU = -1, bestV = -1, bestEstimate = 0;
+        int tabuU = -1, tabuV = -1, tabuEstimate = 0;
+        int numMoves = 0;
+
+        // Explore block-boundary swaps
+        for (int b = 0; b < graph.blockCount(); ++b) {
+            int begin = graph.blockBegin(b);
+            int end = graph.blockBegin(b + 1);
+            if (end - begin < 2) {
+                continue;
+            }
+            for (int side = 0; side < 2; ++side) {
+                int first = side == 0 ? begin : end - 2;
+                if (side == 1 && first == begin) {
+                    break;  // Block of two: both boundary pairs are the same
+                }
+                int u = path[first];
+                int v = path[first + 1];
+                int pos = graph.machinePos(u);
+                ++numMoves;
+                if (graph.jobSucc(u) == v) {
+                    continue;  // Consecutive operations of one job: cannot be reversed
+                }
+                if (visited.contains(hash ^ zobrist.swapDelta(u, pos, v, pos + 1))) {
+                    ++revisitsAvoided;
+                    continue;
+                }
+                int estimate = graph.estimateSwap(u, v);
+                bool isTabu = tabu.isTabu(u, pos + 1, iteration) || tabu.isTabu(v, pos, iteration);
+                if (!isTabu || estimate < bestSolution.makespan) {
+                    if (bestU < 0 || estimate < bestEstimate) {
+                        bestU = u; bestV = v; bestEstimate = estimate;
+                    }
+                } else if (tabuU < 0 || estimate < tabuEstimate) {
+                    tabuU = u; tabuV = v; tabuEstimate = estimate;
+                }
+            }
+        }
+
+        if (numMoves == 0) {
+            break;  // Critical path is a single job: the schedule is optimal
+        }
+        if (bestU < 0 && tabuU < 0) {
+            // Every move leads back to a visited solution or cannot be
+            // reversed: diversify or stop
+            if (++diversifications > MAX_DIVERSIFICATIONS) {
+                break;
+            }
+            for (int k = 0; k < DIVERSIFICATION_SWAPS; ++k) {
+                randomCriticalSwap(hash);
+            }
+            visited.insert(hash);
+            ++fullEvaluations;
+            continue;
+        }
+        if (bestU < 0) {
+            bestU = tabuU;  // Every move is tabu: take the least bad one
+            bestV = tabuV;
+        }
+
+        // Apply the chosen move exactly; the hash, visited set and tabu
+        // memory only follow a swap the graph accepted
+        int pos = graph.machinePos(bestU);
+        if (!graph.swapAdjacent(bestU, bestV)) {
+            continue;
+        }
+        hash ^= zobrist.swapDelta(bestU, pos, bestV, pos + 1);
+        visited.insert(hash);
+        ++fullEvaluations;
+
+        // Forbid both operations from returning to their old machine positions
+        int until = iteration + drawTenure();
+        tabu.forbid(bestU, pos, until);
+        tabu.forbid(bestV, pos + 1, until);
+
+        // Update the best solution found
+        if (graph.makespan() < bestSolution.makespan) {
+            graph.toSchedule(bestSolution.schedule.data());
+            bestSolution.makespan = graph.makespan();
+        }
+    }
+
+    return bestSolution;
+}
+
+// Best candidate seen by one FULL_SWAPS worker, ordered by (makespan, pos1, pos2)
+struct SwapCandidate {
+    int makespan;
+    int pos1;
+    int pos2;
+};
+
+bool betterCandidate(const SwapCandidate& a, const SwapCandidate& b) {
+    if (a.makespan != b.makespan) return a.makespan < b.makespan;
+    if (a.pos1 != b.pos1) return a.pos1 < b.pos1;
+    return a.pos2 < b.pos2;
+}
+
+// Scratch buffers owned by one FULL_SWAPS worker thread
+struct SwapWorker {
+    vector<int> schedule;
+    vector<int> scratch;
+    SwapCandidate best;
+    long long evaluations;
+    long long revisits;
+};
+
+// Tabu Search over the full swap neighborhood. Rows of the pos1 x pos2 move
+// matrix are scored in parallel against shared prefix snapshots; the winner is
+// the lexicographically smallest (makespan, pos1, pos2), so the trajectory
+// does not depend on the number of threads.
+Solution fullSwapTabuSearch(const Solution& initialSolution, int numThreads) {
+    Solution currentSolution = initialSolution;
+    Solution bestSolution = currentSolution;
+    int length = (int)currentSolution.schedule.size();
+
+    TabuMemory tabu;  // Attribute: job x schedule position
+    tabu.init(numJobs, length);
+    incrementalEvaluator.rebuild(currentSolution.schedule);
+
+    // Fingerprint of the schedule: position x job
+    zobrist.init(length, numJobs);
+    visited.init(VISITED_SET_LOG2);
+    uint64_t hash = zobrist.hash(currentSolution.schedule.data(), length);
+    visited.insert(hash);
+
+    ThreadPool pool(numThreads);
+    vector<SwapWorker> workers(pool.size());
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].evaluations = 0;
+        workers[t].revisits = 0;
+    }
+
+    // Tabu Search loop
+    for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].schedule = currentSolution.schedule;
+            workers[t].best.makespan = -1;
+        }
+        int aspiration = bestSolution.makespan;
+
+        // Explore neighbors
+        pool.parallelFor(length, 1, [&](int begin, int end, int thread) {
+            SwapWorker& worker = workers[thread];
+            vector<int>& schedule = worker.schedule;
+            for (int pos1 = begin; pos1 < end; ++pos1) {
+                for (int pos2 = pos1 + 1; pos2 < length; ++pos2) {
+                    if (schedule[pos1] == schedule[pos2]) {
+                        continue;
+                    }
+                    if (visited.contains(hash ^ zobrist.swapDelta(pos1, schedule[pos1], pos2, schedule[pos2]))) {
+                        ++worker.revisits;
+                        continue;
+                    }
+                    bool isTabu = tabu.isTabu(schedule[pos1], pos2, iteration) || tabu.isTabu(schedule[pos2], pos1, iteration);
+                    swap(schedule[pos1], schedule[pos2]);
+                    SwapCandidate candidate = {incrementalEvaluator.evaluate(schedule.data(), pos1, worker.scratch), pos1, pos2};
+                    swap(schedule[pos1], schedule[pos2]);
+                    ++worker.evaluations;
+
+                    if ((!isTabu || candidate.makespan < aspiration) &&
+                        (worker.best.makespan < 0 || betterCandidate(candidate, worker.best))) {
+                        worker.best = candidate;
+                    }
+                }
+            }
+        });
+
+        // Deterministic reduction over the workers
+        SwapCandidate best = {-1, 0, 0};
+        for (size_t t = 0; t < workers.size(); ++t) {
+            if (workers[t].best.makespan >= 0 && (best.makespan < 0 || betterCandidate(workers[t].best, best))) {
+                best = workers[t].best;
+            }
+        }
+        if (best.makespan < 0) {
+            // Every move is tabu or revisits a solution: diversify or stop
+            if (++diversifications > MAX_DIVERSIFICATIONS) {
+                break;
+            }
+            int firstChanged = length;
+            for (int k = 0; k < DIVERSIFICATION_SWAPS; ++k) {
+                int pos1 = rng.below(length);
+                int pos2 = rng.below(length);
+                hash ^= zobrist.swapDelta(pos1, currentSolution.schedule[pos1], pos2, currentSolution.schedule[pos2]);
+                swap(currentSolution.schedule[pos1], currentSolution.schedule[pos2]);
+                firstChanged = min(firstChanged, min(pos1, pos2));
+            }
+            currentSolution.makespan = incrementalEvaluator.commit(currentSolution.schedule.data(), firstChanged);
+            visited.insert(hash);
+            continue;
+        }
+
+        // Forbid both jobs from returning to the positions they left
+        int until = iteration + drawTenure();
+        tabu.forbid(currentSolution.schedule[best.pos1], best.pos1, until);
+        tabu.forbid(currentSolution.schedule[best.pos2], best.pos2, until);
+
+        hash ^= zobrist.swapDelta(best.pos1, currentSolution.schedule[best.pos1], best.pos2, currentSolution.schedule[best.pos2]);
+        visited.insert(hash);
+        swap(currentSolution.schedule[best.pos1], currentSolution.schedule[best.pos2]);
+        currentSolution.makespan = incrementalEvaluator.commit(currentSolution.schedule.data(), best.pos1);
+
+        // Update the best solution found
+        if (currentSolution.makespan < bestSolution.makespan) {
+            bestSolution = currentSolution;
+        }
+    }
+
+    for (size_t t = 0; t < workers.size(); ++t) {
+        fullEvaluations += workers[t].evaluations;
+        revisitsAvoided += workers[t].revisits;
+    }
+    return bestSolution;
+}
+
+// Run FULL_SWAPS from one start with 1, 2, 4, ... NUM_THREADS threads and print iterations/sec
+void reportThreadScaling() {
+    Solution initialSolution = generateInitialSolution();
+    for (int threads = 1; ; threads = min(threads * 2, NUM_THREADS)) {
+        // Same random stream for every thread count, so the searches match
+        rng.seed(masterSeed, 1);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        Solution result = fullSwapTabuSearch(initialSolution, threads);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Threads: " << threads << "  iterations/sec: " << MAX_ITERATIONS / seconds
+             << "  best makespan: " << result.makespan << endl;
+        if (threads == NUM_THREADS) {
+            break;
+        }
+    }
+}
+
+// Tabu Search over random position swaps
+Solution randomSwapTabuSearch() {
+    Solution currentSolution = generateInitialSolution();
+    Solution bestSolution = currentSolution;
+
+    TabuMemory tabu;  // Attribute: job x schedule position
+    tabu.init(numJobs, (int)currentSolution.schedule.size());
+    incrementalEvaluator.rebuild(currentSolution.schedule);
+
+    // Fingerprint of the schedule: position x job
+    zobrist.init((int)currentSolution.schedule.size(), numJobs);
+    visited.init(VISITED_SET_LOG2);
+    uint64_t hash = zobrist.hash(currentSolution.schedule.data(), (int)currentSolution.schedule.size());
+    visited.insert(hash);
 
     // Tabu Search loop
     for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
         Solution bestNeighbor = currentSolution;
+        int bestPos1 = -1, bestPos2 = -1;
+        int numEvaluated = 0;
         
-        // Explore neighbors
+        // Explore neighbors, skipping those already visited
         for (int i = 0; i < numJobs; ++i) {
-            Solution neighbor = getNeighbor(currentSolution);
+            int pos1 = rng.below((int)currentSolution.schedule.size());
+            int pos2 = rng.below((int)currentSolution.schedule.size());
+            if (currentSolution.schedule[pos1] == currentSolution.schedule[pos2]) {
+                continue;  // Same job (or same position): the schedule would not change
+            }
+            if (visited.contains(hash ^ zobrist.swapDelta(pos1, currentSolution.schedule[pos1], pos2, currentSolution.schedule[pos2]))) {
+                ++revisitsAvoided;
+                continue;
+            }
+            Solution neighbor = getNeighbor(currentSolution, pos1, pos2);
+            ++numEvaluated;
             if (neighbor.makespan < bestNeighbor.makespan) {
                 bestNeighbor = neighbor;
+                bestPos1 = pos1;
+                bestPos2 = pos2;
             }
         }
-
-        // Check if the move is tabu
-        bool isTabu = false;
-        queue<pair<int, int> > tempTabuList = tabuList;  // Added space between right angle brackets
-        while (!tempTabuList.empty()) {
-            pair<int, int> move = tempTabuList.front();
-            tempTabuList.pop();
-            if ((move.first == bestNeighbor.schedule[0] && move.second == bestNeighbor.schedule[1]) ||
-                (move.first == bestNeighbor.schedule[1] && move.second == bestNeighbor.schedule[0])) {
-                isTabu = true;
+        if (numEvaluated == 0) {
+            // Every sampled move revisits a solution: diversify or stop
+            if (++diversifications > MAX_DIVERSIFICATIONS) {
                 break;
             }
+            int length = (int)currentSolution.schedule.size();
+            int firstChanged = length;
+            for (int k = 0; k < DIVERSIFICATION_SWAPS; ++k) {
+                int pos1 = rng.below(length);
+                int pos2 = rng.below(length);
+                hash ^= zobrist.swapDelta(pos1, currentSolution.schedule[pos1], pos2, currentSolution.schedule[pos2]);
+                swap(currentSolution.schedule[pos1], currentSolution.schedule[pos2]);
+                firstChanged = min(firstChanged, min(pos1, pos2));
+            }
+            currentSolution.makespan = incrementalEvaluator.commit(currentSolution.schedule.data(), firstChanged);
+            visited.insert(hash);
+            ++fullEvaluations;
+            if (currentSolution.makespan < bestSolution.makespan) {
+                bestSolution = currentSolution;
+            }
+            continue;
         }
+        if (bestPos1 < 0) {
+            continue;  // No improving neighbor sampled
+        }
+
+        // Check if the move is tabu: a job returning to a position it recently left
+        int job1 = currentSolution.schedule[bestPos1];
+        int job2 = currentSolution.schedule[bestPos2];
+        bool isTabu = tabu.isTabu(job1, bestPos2, iteration) || tabu.isTabu(job2, bestPos1, iteration);
 
         // Update solution if not tabu or if better than the best known solution
         if (!isTabu || bestNeighbor.makespan < bestSolution.makespan) {
+            hash ^= zobrist.swapDelta(bestPos1, job1, bestPos2, job2);
+            visited.insert(hash);
             currentSolution = bestNeighbor;
+            incrementalEvaluator.commit(currentSolution.schedule.data(), min(bestPos1, bestPos2));
 
-            // Update tabu list
-            if (tabuList.size() >= TABU_TENURE) {
-                tabuList.pop();
-            }
-            tabuList.push(make_pair(currentSolution.schedule[0], currentSolution.schedule[1]));
+            // Update tabu memory
+            int until = iteration + drawTenure();
+            tabu.forbid(job1, bestPos1, until);
+            tabu.forbid(job2, bestPos2, until);
         }
 
         // Update the best solution found
@@ -135,43 +490,59 @@ Solution tabuSearch() {
     return bestSolution;
 }
 
-int main() {
-    // Initialize jobs data manually
-    jobs.resize(3);
-    Task task1 = {0, 0, 3};
-    Task task2 = {0, 1, 2};
-    Task task3 = {0, 2, 2};
-    jobs[0].push_back(task1);
-    jobs[0].push_back(task2);
-    jobs[0].push_back(task3);
-
-    Task task4 = {1, 0, 2};
-    Task task5 = {1, 1, 1};
-    Task task6 = {1, 2, 4};
-    jobs[1].push_back(task4);
-    jobs[1].push_back(task5);
-    jobs[1].push_back(task6);
-
-    Task task7 = {2, 0, 4};
-    Task task8 = {2, 1, 3};
-    Task task9 = {2, 2, 3};
-    jobs[2].push_back(task7);
-    jobs[2].push_back(task8);
-    jobs[2].push_back(task9);
-
-    numJobs = jobs.size();
-
-    // Initialize random seed
-    initializeRandom();
-
-    // Run Tabu Search
-    clock_t start = clock();
-    Solution bestSolution = tabuSearch();
-    clock_t end = clock();
-
-    double duration = (double)(end - start) / CLOCKS_PER_SEC * 1000;
-    cout << "Best makespan (fitness): " << bestSolution.makespan << endl;
-    cout << "Execution time: " << duration << " ms" << endl;
+// Main Tabu Search function
+Solution tabuSearch() {
+    if (NEIGHBORHOOD == CRITICAL_BLOCKS) {
+        return criticalBlockTabuSearch();
+    }
+    if (NEIGHBORHOOD == FULL_SWAPS) {
+        return fullSwapTabuSearch(generateInitialSolution(), NUM_THREADS);
+    }
+    return randomSwapTabuSearch();
+}
+
+int main(int argc, char** argv) {
+    masterSeed = parseSeed(argc, argv);
+    cout << "Seed: " << masterSeed << endl;
+
+    vector<NamedInstance> instances;
+    if (!loadCommandLineInstances(argc, argv, instances)) {
+        return 1;
+    }
+
+    // Every instance starts from the master seed, so its result does not
+    // depend on the instances before it
+    for (size_t k = 0; k < instances.size(); ++k) {
+        instance = move(instances[k].instance);
+        cout << "Instance: " << instances[k].name << " (" << instance.numJobs << "x"
+             << instance.numMachines << ")" << endl;
+        evaluator.init(instance);
+        incrementalEvaluator.init(instance);
+        graph.init(instance);
+        numJobs = instance.numJobs;
+
+        if (NEIGHBORHOOD == FULL_SWAPS && REPORT_THREAD_SCALING) {
+            reportThreadScaling();
+        }
+
+        // Counters and the RNG start fresh for the reported run
+        rng.seed(masterSeed);
+        fullEvaluations = 0;
+        revisitsAvoided = 0;
+        diversifications = 0;
+
+        // Run Tabu Search, timed by wall clock since FULL_SWAPS uses the pool
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        Solution bestSolution = tabuSearch();
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+        double duration = chrono::duration<double, milli>(end - start).count();
+        cout << "Best makespan (fitness): " << bestSolution.makespan << endl;
+        cout << "Full evaluations: " << fullEvaluations << endl;
+        cout << "Revisits avoided: " << revisitsAvoided << endl;
+        cout << "Diversifications: " << diversifications << endl;
+        cout << "Execution time: " << duration << " ms" << endl;
+    }
 
     return 0;
 }
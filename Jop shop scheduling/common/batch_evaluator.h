@@ -0,0 +1,71 @@
+// Makespans of many schedules at once, decoded in SIMD lanes
+#ifndef BATCH_EVALUATOR_H
+#define BATCH_EVALUATOR_H
+
+#include <vector>
+#include <climits>
+#include <algorithm>
+
+#include "jssp.h"
+#include "lockstep_evaluator.h"
+
+// Decodes any number of row-major schedules. With AVX2 or AVX-512 they go
+// in groups of LockstepEvaluator::LANES: each group is transposed into the
+// lockstep layout and all of its lanes advance together, and a short last
+// group is padded with copies of its first schedule whose results are
+// dropped. Without SIMD, interleaving only adds the transpose, so the
+// scalar level decodes the schedules one by one with Evaluator.
+class BatchEvaluator {
+public:
+    static constexpr int LANES = LockstepEvaluator::LANES;
+
+    BatchEvaluator() : numOps(0) {}
+    explicit BatchEvaluator(const Instance& inst) { init(inst); }
+
+    void init(const Instance& inst, SimdLevel level = detectSimdLevel()) {
+        numOps = inst.numOps;
+        evaluator.init(inst);
+        lockstep.init(inst, level);
+        lanes.assign((size_t)numOps * LANES, 0);
+        cutoffs.assign(LANES, INT_MAX);
+        results.assign(LANES, 0);
+    }
+
+    SimdLevel level() const { return lockstep.level(); }
+
+    // makespans[k] = makespan of schedules[k], for k < count
+    void evaluate(const int* const* schedules, int count, int* makespans) {
+        if (lockstep.level() == SIMD_SCALAR) {
+            for (int k = 0; k < count; ++k) {
+                makespans[k] = evaluator.makespan(schedules[k], numOps);
+            }
+            return;
+        }
+        for (int first = 0; first < count; first += LANES) {
+            int group = std::min(LANES, count - first);
+            const int* rows[LANES];
+            for (int l = 0; l < LANES; ++l) {
+                rows[l] = schedules[first + (l < group ? l : 0)];
+            }
+            // Position-major, so the writes stream through the group
+            for (int i = 0; i < numOps; ++i) {
+                int* column = &lanes[(size_t)i * LANES];
+                for (int l = 0; l < LANES; ++l) {
+                    column[l] = rows[l][i];
+                }
+            }
+            lockstep.evaluate(lanes.data(), cutoffs.data(), results.data());
+            std::copy(results.begin(), results.begin() + group, makespans + first);
+        }
+    }
+
+private:
+    int numOps;
+    Evaluator evaluator;
+    LockstepEvaluator lockstep;
+    std::vector<int> lanes;    // One group in the lockstep layout
+    std::vector<int> cutoffs;  // INT_MAX: every lane is decoded to the end
+    std::vector<int> results;
+};
+
+#endif
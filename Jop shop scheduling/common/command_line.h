@@ -0,0 +1,32 @@
+// Command-line options shared by all solvers
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+#include <cstring>
+
+// Value of option name ("--seed") given as "--seed N" or "--seed=N", or null
+// when absent. Every option takes a value, so any other argument that does
+// not start with "--" and does not follow one is an instance file.
+inline const char* optionValue(int argc, char** argv, const char* name) {
+    size_t length = std::strlen(name);
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0 && i + 1 < argc) {
+            return argv[i + 1];
+        }
+        if (std::strncmp(argv[i], name, length) == 0 && argv[i][length] == '=') {
+            return argv[i] + length + 1;
+        }
+    }
+    return 0;
+}
+
+// True if argv[i] is an option; optionArguments is how many arguments it spans
+inline bool isOption(int argc, char** argv, int i, int& optionArguments) {
+    if (std::strncmp(argv[i], "--", 2) != 0) {
+        return false;
+    }
+    optionArguments = std::strchr(argv[i], '=') || i + 1 >= argc ? 1 : 2;
+    return true;
+}
+
+#endif
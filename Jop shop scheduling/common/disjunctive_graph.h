@@ -0,0 +1,274 @@
+// Disjunctive graph of a Job-Shop schedule with head/tail times and critical blocks
+#ifndef DISJUNCTIVE_GRAPH_H
+#define DISJUNCTIVE_GRAPH_H
+
+#include <vector>
+#include <algorithm>
+
+#include "jssp.h"
+
+// Operations are nodes; conjunctive arcs follow each job's technological
+// order and disjunctive arcs follow the processing order on each machine.
+// head(op) is the earliest start of op (longest path from the source) and
+// tail(op) is the longest path from the end of op to the sink, so every
+// operation with head + duration + tail == makespan is critical.
+class DisjunctiveGraph {
+public:
+    DisjunctiveGraph() : instance(0), currentMakespan(0), markStamp(0) {}
+    explicit DisjunctiveGraph(const Instance& inst) { init(inst); }
+
+    void init(const Instance& inst) {
+        instance = &inst;
+        int n = inst.numOps;
+        jobPredecessor.assign(n, -1);
+        jobSuccessor.assign(n, -1);
+        for (int j = 0; j < inst.numJobs; ++j) {
+            for (int op = inst.jobOffset[j] + 1; op < inst.jobOffset[j + 1]; ++op) {
+                jobPredecessor[op] = op - 1;
+                jobSuccessor[op - 1] = op;
+            }
+        }
+        machinePredecessor.assign(n, -1);
+        machineSuccessor.assign(n, -1);
+        machinePosition.assign(n, 0);
+        machineSequence.assign(n, 0);
+        order.assign(n, 0);
+        orderPosition.assign(n, 0);
+        heads.assign(n, 0);
+        tails.assign(n, 0);
+        marks.assign(n, 0);
+        window.assign(n, 0);
+        nextOp.assign(inst.numJobs, 0);
+        machineFill.assign(inst.numMachines, 0);
+        path.reserve(n);
+        blockStart.reserve(n + 1);
+        currentMakespan = 0;
+        markStamp = 0;
+    }
+
+    // Build the machine sequences and all heads/tails from an operation-based schedule
+    int build(const int* schedule) {
+        const Instance& inst = *instance;
+        std::copy(inst.jobOffset.begin(), inst.jobOffset.end() - 1, nextOp.begin());
+        std::copy(inst.machineOffset.begin(), inst.machineOffset.end() - 1, machineFill.begin());
+        std::fill(machinePredecessor.begin(), machinePredecessor.end(), -1);
+        std::fill(machineSuccessor.begin(), machineSuccessor.end(), -1);
+
+        for (int i = 0; i < inst.numOps; ++i) {
+            int op = nextOp[schedule[i]]++;
+            int machineID = inst.opMachine[op];
+            int pos = machineFill[machineID]++;
+            machineSequence[pos] = op;
+            machinePosition[op] = pos - inst.machineOffset[machineID];
+            if (pos > inst.machineOffset[machineID]) {
+                int prev = machineSequence[pos - 1];
+                machinePredecessor[op] = prev;
+                machineSuccessor[prev] = op;
+            }
+            order[i] = op;
+            orderPosition[op] = i;
+        }
+
+        updateHeads(0);
+        updateTails(inst.numOps - 1);
+        return currentMakespan;
+    }
+
+    int build(const std::vector<int>& schedule) {
+        return build(schedule.data());
+    }
+
+    // Write the current topological order back as an operation-based schedule
+    void toSchedule(int* schedule) const {
+        for (int i = 0; i < instance->numOps; ++i) {
+            schedule[i] = instance->opJob[order[i]];
+        }
+    }
+
+    // Swap u with its machine successor v and update heads/tails.
+    // Returns false (graph unchanged) if the reversal would create a cycle.
+    bool swapAdjacent(int u, int v) {
+        if (machineSuccessor[u] != v) {
+            return false;
+        }
+        int pu = orderPosition[u];
+        int pv = orderPosition[v];
+
+        // Mark the operations between u and v in the order that must precede v
+        ++markStamp;
+        for (int i = pv - 1; i > pu; --i) {
+            int w = order[i];
+            int js = jobSuccessor[w];
+            int ms = machineSuccessor[w];
+            if (js == v || ms == v || (js >= 0 && marks[js] == markStamp) || (ms >= 0 && marks[ms] == markStamp)) {
+                marks[w] = markStamp;
+            }
+        }
+        int js = jobSuccessor[u];
+        if (js == v || (js >= 0 && marks[js] == markStamp)) {
+            return false;  // u reaches v through its job successor
+        }
+
+        // Reorder [pu, pv]: v's ancestors, v, u, then the rest
+        int count = 0;
+        for (int i = pu + 1; i < pv; ++i) {
+            if (marks[order[i]] == markStamp) {
+                window[count++] = order[i];
+            }
+        }
+        window[count++] = v;
+        window[count++] = u;
+        for (int i = pu + 1; i < pv; ++i) {
+            if (marks[order[i]] != markStamp) {
+                window[count++] = order[i];
+            }
+        }
+        for (int i = 0; i < count; ++i) {
+            order[pu + i] = window[i];
+            orderPosition[window[i]] = pu + i;
+        }
+
+        // Relink p -> v -> u -> x on the machine
+        int p = machinePredecessor[u];
+        int x = machineSuccessor[v];
+        if (p >= 0) machineSuccessor[p] = v;
+        if (x >= 0) machinePredecessor[x] = u;
+        machinePredecessor[v] = p;
+        machineSuccessor[v] = u;
+        machinePredecessor[u] = v;
+        machineSuccessor[u] = x;
+        int base = instance->machineOffset[instance->opMachine[u]];
+        std::swap(machinePosition[u], machinePosition[v]);
+        machineSequence[base + machinePosition[u]] = u;
+        machineSequence[base + machinePosition[v]] = v;
+
+        // Heads only change from pu onwards, tails only up to pv
+        updateHeads(pu);
+        updateTails(pv);
+        return true;
+    }
+
+    // Lower-bound estimate of the makespan after swapping u with its machine
+    // successor v, from the current heads and tails only (constant time)
+    int estimateSwap(int u, int v) const {
+        const int* duration = instance->opDuration.data();
+        int p = machinePredecessor[u];
+        int x = machineSuccessor[v];
+        int ju = jobPredecessor[u];
+        int jv = jobPredecessor[v];
+        int su = jobSuccessor[u];
+        int sv = jobSuccessor[v];
+
+        int headV = std::max(jv >= 0 ? heads[jv] + duration[jv] : 0, p >= 0 ? heads[p] + duration[p] : 0);
+        int headU = std::max(ju >= 0 ? heads[ju] + duration[ju] : 0, headV + duration[v]);
+        int tailU = std::max(su >= 0 ? tails[su] + duration[su] : 0, x >= 0 ? tails[x] + duration[x] : 0);
+        int tailV = std::max(sv >= 0 ? tails[sv] + duration[sv] : 0, tailU + duration[u]);
+        return std::max(headV + duration[v] + tailV, headU + duration[u] + tailU);
+    }
+
+    // Trace one critical path from the source and split it into machine blocks
+    void computeCriticalPath() {
+        path.clear();
+        blockStart.clear();
+        int op = -1;
+        for (int j = 0; j < instance->numJobs && op < 0; ++j) {
+            int first = instance->jobOffset[j];
+            if (instance->jobOffset[j + 1] > first && isCritical(first) && heads[first] == 0) {
+                op = first;
+            }
+        }
+
+        while (op >= 0) {
+            if (path.empty() || machinePredecessor[op] != path.back()) {
+                blockStart.push_back((int)path.size());
+            }
+            path.push_back(op);
+            int end = heads[op] + instance->opDuration[op];
+            int ms = machineSuccessor[op];
+            int js = jobSuccessor[op];
+            if (ms >= 0 && heads[ms] == end && isCritical(ms)) {
+                op = ms;
+            } else if (js >= 0 && heads[js] == end && isCritical(js)) {
+                op = js;
+            } else {
+                op = -1;
+            }
+        }
+        blockStart.push_back((int)path.size());
+    }
+
+    bool isCritical(int op) const {
+        return heads[op] + instance->opDuration[op] + tails[op] == currentMakespan;
+    }
+
+    int makespan() const { return currentMakespan; }
+    int head(int op) const { return heads[op]; }
+    int tail(int op) const { return tails[op]; }
+    int jobPred(int op) const { return jobPredecessor[op]; }
+    int jobSucc(int op) const { return jobSuccessor[op]; }
+    int machinePred(int op) const { return machinePredecessor[op]; }
+    int machineSucc(int op) const { return machineSuccessor[op]; }
+    int machinePos(int op) const { return machinePosition[op]; }
+
+    // Critical path from computeCriticalPath(); block b is
+    // criticalPath()[blockBegin(b) .. blockBegin(b + 1))
+    const std::vector<int>& criticalPath() const { return path; }
+    int blockCount() const { return (int)blockStart.size() - 1; }
+    int blockBegin(int b) const { return blockStart[b]; }
+
+private:
+    void updateHeads(int from) {
+        const int* duration = instance->opDuration.data();
+        for (int i = from; i < instance->numOps; ++i) {
+            int op = order[i];
+            int jp = jobPredecessor[op];
+            int mp = machinePredecessor[op];
+            int start = 0;
+            if (jp >= 0) start = heads[jp] + duration[jp];
+            if (mp >= 0) start = std::max(start, heads[mp] + duration[mp]);
+            heads[op] = start;
+        }
+        currentMakespan = 0;
+        for (int j = 0; j < instance->numJobs; ++j) {
+            int last = instance->jobOffset[j + 1] - 1;
+            if (last >= instance->jobOffset[j]) {
+                currentMakespan = std::max(currentMakespan, heads[last] + duration[last]);
+            }
+        }
+    }
+
+    void updateTails(int from) {
+        const int* duration = instance->opDuration.data();
+        for (int i = from; i >= 0; --i) {
+            int op = order[i];
+            int js = jobSuccessor[op];
+            int ms = machineSuccessor[op];
+            int rest = 0;
+            if (js >= 0) rest = tails[js] + duration[js];
+            if (ms >= 0) rest = std::max(rest, tails[ms] + duration[ms]);
+            tails[op] = rest;
+        }
+    }
+
+    const Instance* instance;
+    int currentMakespan;
+    int markStamp;
+    std::vector<int> jobPredecessor;
+    std::vector<int> jobSuccessor;
+    std::vector<int> machinePredecessor;
+    std::vector<int> machineSuccessor;
+    std::vector<int> machinePosition;  // Index of each operation on its machine
+    std::vector<int> machineSequence;  // Processing order, laid out like Instance::machineOps
+    std::vector<int> order;            // Topological order of the operations
+    std::vector<int> orderPosition;
+    std::vector<int> heads;
+    std::vector<int> tails;
+    std::vector<int> marks;
+    std::vector<int> window;
+    std::vector<int> nextOp;
+    std::vector<int> machineFill;
+    std::vector<int> path;
+    std::vector<int> blockStart;
+};
+
+#endif
@@ -0,0 +1,77 @@
+// Fenwick tree of non-negative weights for O(log n) roulette-wheel sampling
+#ifndef FENWICK_TREE_H
+#define FENWICK_TREE_H
+
+#include <vector>
+
+// Prefix sums of n weights with O(log n) updates. find(r) returns the item
+// whose cumulative range contains r, so a uniform r in [0, total()) picks
+// item i with probability weight(i) / total(); setting a weight to 0
+// removes the item from the wheel.
+class FenwickTree {
+public:
+    FenwickTree() : n(0), topBit(0) {}
+
+    void init(int size) {
+        n = size;
+        tree.assign(n + 1, 0.0);
+        weights.assign(n, 0.0);
+        topBit = 1;
+        while (topBit * 2 <= n) {
+            topBit *= 2;
+        }
+    }
+
+    // Load all weights in O(n)
+    void build(const double* values) {
+        for (int i = 0; i < n; ++i) {
+            weights[i] = values[i];
+            tree[i + 1] = values[i];
+        }
+        for (int i = 1; i <= n; ++i) {
+            int parent = i + (i & -i);
+            if (parent <= n) {
+                tree[parent] += tree[i];
+            }
+        }
+    }
+
+    double weight(int i) const { return weights[i]; }
+
+    void set(int i, double value) {
+        double delta = value - weights[i];
+        weights[i] = value;
+        for (int k = i + 1; k <= n; k += k & -k) {
+            tree[k] += delta;
+        }
+    }
+
+    double total() const {
+        double sum = 0.0;
+        for (int k = n; k > 0; k -= k & -k) {
+            sum += tree[k];
+        }
+        return sum;
+    }
+
+    // Smallest i with weight(0) + ... + weight(i) > r, or n - 1 if rounding
+    // leaves r at or past the total
+    int find(double r) const {
+        int pos = 0;
+        for (int step = topBit; step > 0; step /= 2) {
+            if (pos + step <= n && tree[pos + step] <= r) {
+                pos += step;
+                r -= tree[pos];
+            }
+        }
+        return pos < n ? pos : n - 1;
+    }
+
+private:
+    int n;
+    int topBit;
+    std::vector<double> tree;     // 1-based partial sums
+    std::vector<double> weights;
+};
+
+#endif
@@ -0,0 +1,58 @@
+// Bounded, thread-safe cache of makespans keyed by 64-bit schedule hashes
+#ifndef FITNESS_CACHE_H
+#define FITNESS_CACHE_H
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+// Direct-mapped table of 2^capacityLog2 entries: a hash can only live in
+// slot hash & mask, and a new entry simply replaces whatever was there, so
+// memory stays fixed however long the search runs. Slots are guarded by a
+// small set of striped locks, so threads rarely contend on the same one.
+class FitnessCache {
+public:
+    FitnessCache() : mask(0) {}
+
+    void init(int capacityLog2) {
+        entries.assign((size_t)1 << capacityLog2, Entry());
+        mask = entries.size() - 1;
+    }
+
+    // Makespan stored for hash, or false if it is not cached
+    bool lookup(uint64_t hash, int& makespan) {
+        size_t slot = (size_t)hash & mask;
+        std::lock_guard<std::mutex> lock(locks[slot % NUM_LOCKS]);
+        const Entry& entry = entries[slot];
+        if (entry.valid && entry.hash == hash) {
+            makespan = entry.makespan;
+            return true;
+        }
+        return false;
+    }
+
+    void insert(uint64_t hash, int makespan) {
+        size_t slot = (size_t)hash & mask;
+        std::lock_guard<std::mutex> lock(locks[slot % NUM_LOCKS]);
+        Entry& entry = entries[slot];
+        entry.hash = hash;
+        entry.makespan = makespan;
+        entry.valid = true;
+    }
+
+private:
+    static const int NUM_LOCKS = 64;
+
+    struct Entry {
+        uint64_t hash;
+        int makespan;
+        bool valid;
+        Entry() : hash(0), makespan(0), valid(false) {}
+    };
+
+    std::vector<Entry> entries;
+    size_t mask;
+    std::mutex locks[NUM_LOCKS];
+};
+
+#endif
@@ -0,0 +1,126 @@
+// Decoders compiled for the instance shapes we run most often
+#ifndef FIXED_SHAPE_H
+#define FIXED_SHAPE_H
+
+#include <array>
+#include <algorithm>
+
+// Decoders for exactly J jobs of M operations each, so operation k of job j
+// is j * M + k. Loop bounds and state offsets are constants and the decoder
+// state lives in std::arrays on the stack, where the compiler knows no
+// store can alias the schedule or the operation tables, so it keeps more
+// in registers and unrolls the inner loop.
+template <int J, int M>
+struct FixedShape {
+    static constexpr int NUM_OPS = J * M;
+    static constexpr int STATE_SIZE = M + 2 * J + 1;  // Same layout as IncrementalEvaluator
+
+    // Makespan of a whole schedule, as Evaluator::makespan
+    static int makespan(const int* opMachine, const int* opDuration, const int* schedule) {
+        std::array<int, M> machine;
+        std::array<int, J> job;
+        std::array<int, J> next;
+        machine.fill(0);
+        job.fill(0);
+        for (int j = 0; j < J; ++j) {
+            next[j] = j * M;
+        }
+#pragma GCC unroll 8
+        for (int i = 0; i < NUM_OPS; ++i) {
+            int jobID = schedule[i];
+            int op = next[jobID]++;
+            int machineID = opMachine[op];
+            int end = std::max(machine[machineID], job[jobID]) + opDuration[op];
+            machine[machineID] = end;
+            job[jobID] = end;
+        }
+        // Every job ends with its last operation, so the makespan is the
+        // latest job completion
+        int result = 0;
+        for (int j = 0; j < J; ++j) {
+            result = std::max(result, job[j]);
+        }
+        return result;
+    }
+
+    // Resume decoding at position from, as IncrementalEvaluator::decode.
+    // state is only read: the work happens on a stack copy, and a non-null
+    // record receives it every stride positions.
+    static int decode(const int* opMachine, const int* opDuration, const int* schedule, int from,
+                      const int* state, int* record, int stride, int cutoff) {
+        std::array<int, STATE_SIZE> local;
+        std::copy(state, state + STATE_SIZE, local.begin());
+        int* machine = local.data();
+        int* job = machine + M;
+        int* next = job + J;
+
+        int result = local[STATE_SIZE - 1];
+        if (result > cutoff) {
+            return result;
+        }
+        // Runs of positions between snapshots, so the inner loop has no
+        // snapshot test
+        for (int i = from; i < NUM_OPS; ) {
+            int runEnd = NUM_OPS;
+            if (record) {
+                if (i % stride == 0) {
+                    local[STATE_SIZE - 1] = result;
+                    std::copy(local.begin(), local.end(), record + (size_t)(i / stride) * STATE_SIZE);
+                }
+                runEnd = std::min(NUM_OPS, (i / stride + 1) * stride);
+            }
+            for (; i < runEnd; ++i) {
+                int jobID = schedule[i];
+                int op = next[jobID]++;
+                int machineID = opMachine[op];
+                int end = std::max(machine[machineID], job[jobID]) + opDuration[op];
+                if (end > cutoff) {
+                    return end;
+                }
+                machine[machineID] = end;
+                job[jobID] = end;
+                result = std::max(result, end);
+            }
+        }
+        return result;
+    }
+};
+
+typedef int (*FixedMakespanFn)(const int* opMachine, const int* opDuration, const int* schedule);
+typedef int (*FixedDecodeFn)(const int* opMachine, const int* opDuration, const int* schedule, int from,
+                             const int* state, int* record, int stride, int cutoff);
+
+// Specialized decoders for a shape, or null ones when it has none
+struct FixedShapeKernels {
+    FixedMakespanFn makespan;
+    FixedDecodeFn decode;
+};
+
+template <int J, int M>
+FixedShapeKernels fixedShapeKernels() {
+    FixedShapeKernels kernels = {&FixedShape<J, M>::makespan, &FixedShape<J, M>::decode};
+    return kernels;
+}
+
+// Runtime dispatch on the instance shape; `uniform` means every job has
+// exactly numMachines operations
+inline FixedShapeKernels selectFixedShape(int numJobs, int numMachines, bool uniform) {
+    if (uniform) {
+        if (numJobs == 10 && numMachines == 10) {
+            return fixedShapeKernels<10, 10>();
+        }
+        if (numJobs == 15 && numMachines == 15) {
+            return fixedShapeKernels<15, 15>();
+        }
+        if (numJobs == 20 && numMachines == 5) {
+            return fixedShapeKernels<20, 5>();
+        }
+        if (numJobs == 50 && numMachines == 20) {
+            return fixedShapeKernels<50, 20>();
+        }
+    }
+    FixedShapeKernels none = {0, 0};
+    return none;
+}
+
+#endif
@@ -0,0 +1,143 @@
+// Resumable makespan evaluator with periodic prefix snapshots
+#ifndef INCREMENTAL_EVALUATOR_H
+#define INCREMENTAL_EVALUATOR_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <climits>
+
+#include "jssp.h"
+
+// Keeps the decoder state (machine times, job times, next operation of each
+// job and the partial makespan) every `stride` positions of the current
+// schedule. A candidate that equals the current schedule before position p
+// is decoded from the last snapshot at or before p instead of from 0.
+// Shapes listed in selectFixedShape() decode with a compiled kernel.
+class IncrementalEvaluator {
+public:
+    IncrementalEvaluator() : instance(0), length(0), stride(1), stateSize(0), currentMakespan(0), fixedDecode(0) {}
+    explicit IncrementalEvaluator(const Instance& inst, int snapshotStride = 0) { init(inst, snapshotStride); }
+
+    // Size the buffers for the instance; a stride of 0 picks about sqrt(numOps)
+    void init(const Instance& inst, int snapshotStride = 0) {
+        instance = &inst;
+        length = inst.numOps;
+        stride = snapshotStride > 0 ? snapshotStride : std::max(1, (int)sqrt((double)length));
+        stateSize = inst.numMachines + 2 * inst.numJobs + 1;
+        work.assign(stateSize, 0);
+        snapshots.assign((size_t)(length / stride + 1) * stateSize, 0);
+        currentMakespan = 0;
+        fixedDecode = selectFixedShape(inst.numJobs, inst.numMachines, isUniformShape(inst)).decode;
+    }
+
+    // Decode the whole schedule, record its snapshots and make it current
+    int rebuild(const int* schedule) {
+        return commit(schedule, 0);
+    }
+
+    int rebuild(const std::vector<int>& schedule) {
+        return rebuild(schedule.data());
+    }
+
+    // Makespan of a candidate that matches the current schedule before firstChanged
+    int evaluate(const int* schedule, int firstChanged) {
+        if (firstChanged >= length) {
+            return currentMakespan;
+        }
+        return decode(schedule, restore(firstChanged, work.data()), work.data(), 0, INT_MAX);
+    }
+
+    // Like evaluate(), but stops decoding as soon as any completion time
+    // exceeds cutoff. The result is exact when it is <= cutoff; otherwise it
+    // is only known to be > cutoff.
+    int evaluate(const int* schedule, int firstChanged, int cutoff) {
+        if (firstChanged >= length) {
+            return currentMakespan;
+        }
+        return decode(schedule, restore(firstChanged, work.data()), work.data(), 0, cutoff);
+    }
+
+    // Same as evaluate() with caller-owned scratch state, so several threads
+    // can score candidates against the same snapshots concurrently
+    int evaluate(const int* schedule, int firstChanged, std::vector<int>& scratch) const {
+        if (firstChanged >= length) {
+            return currentMakespan;
+        }
+        scratch.resize(stateSize);
+        return decode(schedule, restore(firstChanged, scratch.data()), scratch.data(), 0, INT_MAX);
+    }
+
+    // Accept a candidate: refresh the snapshots from firstChanged onwards
+    int commit(const int* schedule, int firstChanged) {
+        if (firstChanged >= length) {
+            return currentMakespan;
+        }
+        currentMakespan = decode(schedule, restore(firstChanged, work.data()), work.data(), snapshots.data(), INT_MAX);
+        return currentMakespan;
+    }
+
+    int makespan() const { return currentMakespan; }
+
+private:
+    // Load the last snapshot at or before pos into state, return its position
+    int restore(int pos, int* state) const {
+        int s = pos / stride;
+        if (s == 0) {
+            std::fill(state, state + stateSize, 0);
+            std::copy(instance->jobOffset.begin(), instance->jobOffset.end() - 1,
+                      state + instance->numMachines + instance->numJobs);
+        } else {
+            std::copy(snapshots.begin() + (size_t)s * stateSize,
+                      snapshots.begin() + (size_t)(s + 1) * stateSize, state);
+        }
+        return s * stride;
+    }
+
+    // Decode from `from` onwards; a non-null record receives the snapshots.
+    // Returns early with the first completion time above cutoff.
+    int decode(const int* schedule, int from, int* state, int* record, int cutoff) const {
+        const int* opMachine = instance->opMachine.data();
+        const int* opDuration = instance->opDuration.data();
+        if (fixedDecode) {
+            return fixedDecode(opMachine, opDuration, schedule, from, state, record, stride, cutoff);
+        }
+        int* machine = state;
+        int* job = machine + instance->numMachines;
+        int* next = job + instance->numJobs;
+        int& partial = state[stateSize - 1];
+
+        int result = partial;
+        if (result > cutoff) {
+            return result;
+        }
+        for (int i = from; i < length; ++i) {
+            if (record && i % stride == 0) {
+                partial = result;
+                std::copy(state, state + stateSize, record + (size_t)(i / stride) * stateSize);
+            }
+            int jobID = schedule[i];
+            int op = next[jobID]++;
+            int machineID = opMachine[op];
+            int end = std::max(machine[machineID], job[jobID]) + opDuration[op];
+            if (end > cutoff) {
+                return end;
+            }
+            machine[machineID] = end;
+            job[jobID] = end;
+            result = std::max(result, end);
+        }
+        return result;
+    }
+
+    const Instance* instance;
+    int length;
+    int stride;
+    int stateSize;
+    int currentMakespan;
+    FixedDecodeFn fixedDecode;   // Null for shapes without a compiled decoder
+    std::vector<int> work;       // machineTime | jobTime | nextOp | partial makespan
+    std::vector<int> snapshots;  // One work state every `stride` positions
+};
+
+#endif
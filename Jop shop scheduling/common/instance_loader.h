@@ -0,0 +1,367 @@
+// Loader for OR-Library and Taillard instance files, read through mmap
+#ifndef INSTANCE_LOADER_H
+#define INSTANCE_LOADER_H
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "jssp.h"
+#include "command_line.h"
+
+// An instance and the name it has in its file
+struct NamedInstance {
+    std::string name;
+    Instance instance;
+};
+
+// Parses a whole file held in memory, any number of instances per file:
+//
+// OR-Library (jobshop1.txt, or a bare instance): an optional
+// "instance <name>" line, then a line of exactly two integers "jobs
+// machines", then one line per job of (machine, duration) pairs with
+// 0-based machines. Free text between instances is skipped.
+//
+// Taillard: a "Nb of jobs, Nb of Machines, ..." line followed by a line
+// starting with the job and machine counts, then "Times" with one row of
+// durations per job and "Machines" with one row of 1-based machines per job.
+//
+// Integers are scanned by hand straight out of the buffer and every
+// instance is written directly into the flat layout.
+class InstanceParser {
+public:
+    InstanceParser(const char* begin, const char* limit, const std::string& name)
+        : pos(begin), end(limit), source(name) {}
+
+    // Append every instance to instances; false with a message on malformed input
+    bool parse(std::vector<NamedInstance>& instances, std::string& error) {
+        std::string pendingName;
+        size_t first = instances.size();
+        while (pos < end) {
+            const char* lineStart = pos;
+            const char* lineEnd = findLineEnd(pos);
+            pos = lineEnd < end ? lineEnd + 1 : end;
+
+            const char* text = skipBlanks(lineStart, lineEnd);
+            if (startsWith(text, lineEnd, "instance ")) {
+                const char* name = skipBlanks(text + 9, lineEnd);
+                pendingName.assign(name, trimEnd(name, lineEnd));
+                continue;
+            }
+            long long values[2];
+            bool ok = true;
+            if (contains(text, lineEnd, "Nb of jobs")) {
+                instances.push_back(NamedInstance());
+                ok = parseTaillard(instances.back(), error);
+            } else if (lineIntegers(text, lineEnd, values, 2) == 2) {
+                instances.push_back(NamedInstance());
+                ok = parseOrLibrary(instances.back(), (int)values[0], (int)values[1], error);
+            } else {
+                continue;
+            }
+            NamedInstance& parsed = instances.back();
+            parsed.name = pendingName.empty() ? source + "#" + std::to_string(instances.size() - first) : pendingName;
+            pendingName.clear();
+            if (!ok) {
+                error = source + ": " + parsed.name + ": " + error;
+                instances.pop_back();
+                return false;
+            }
+        }
+        if (instances.size() == first) {
+            error = source + ": no instances found";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    // Job lines of (machine, duration) pairs after the "jobs machines" line
+    bool parseOrLibrary(NamedInstance& named, int numJobs, int numMachines, std::string& error) {
+        Instance& instance = named.instance;
+        if (!startInstance(instance, numJobs, numMachines, error)) {
+            return false;
+        }
+        for (int j = 0; j < numJobs; ++j) {
+            const char* p;
+            const char* lineEnd;
+            do {  // Skip blank lines
+                p = pos;
+                lineEnd = findLineEnd(pos);
+                pos = lineEnd < end ? lineEnd + 1 : end;
+            } while (skipBlanks(p, lineEnd) == lineEnd && pos < end);
+            long long machineID, duration;
+            while (scanInteger(p, lineEnd, machineID)) {
+                if (!scanInteger(p, lineEnd, duration)) {
+                    error = "odd number of values in job " + std::to_string(j);
+                    return false;
+                }
+                if (!addOperation(instance, j, machineID, duration, error)) {
+                    return false;
+                }
+            }
+            if (skipBlanks(p, lineEnd) != lineEnd) {
+                error = "unexpected text in job " + std::to_string(j);
+                return false;
+            }
+            if (instance.opJob.empty() || instance.opJob.back() != j) {
+                error = "job " + std::to_string(j) + " has no operations";
+                return false;
+            }
+            instance.jobOffset[j + 1] = (int)instance.opJob.size();
+        }
+        return finishInstance(instance);
+    }
+
+    // Header values, then the Times and Machines matrices
+    bool parseTaillard(NamedInstance& named, std::string& error) {
+        long long values[2];
+        const char* lineEnd = findLineEnd(pos);
+        if (lineIntegers(pos, lineEnd, values, 2) < 2) {
+            error = "missing job and machine counts";
+            return false;
+        }
+        pos = lineEnd < end ? lineEnd + 1 : end;
+        int numJobs = (int)values[0];
+        int numMachines = (int)values[1];
+
+        Instance& instance = named.instance;
+        if (!startInstance(instance, numJobs, numMachines, error)) {
+            return false;
+        }
+        int numOps = numJobs * numMachines;
+        instance.opMachine.resize(numOps);
+        instance.opDuration.resize(numOps);
+        instance.opJob.resize(numOps);
+        for (int j = 0; j < numJobs; ++j) {
+            instance.jobOffset[j + 1] = (j + 1) * numMachines;
+            std::fill(instance.opJob.begin() + j * numMachines, instance.opJob.begin() + (j + 1) * numMachines, j);
+        }
+
+        long long value;
+        if (!expectWord("Times")) {
+            error = "missing Times section";
+            return false;
+        }
+        for (int op = 0; op < numOps; ++op) {
+            if (!scanInteger(pos, end, value) || value < 0) {
+                error = "bad or missing duration";
+                return false;
+            }
+            instance.opDuration[op] = (int)value;
+        }
+        if (!expectWord("Machines")) {
+            error = "missing Machines section";
+            return false;
+        }
+        for (int op = 0; op < numOps; ++op) {
+            if (!scanInteger(pos, end, value) || value < 1 || value > numMachines) {
+                error = "bad or missing machine";
+                return false;
+            }
+            instance.opMachine[op] = (int)value - 1;
+        }
+        return finishInstance(instance);
+    }
+
+    bool startInstance(Instance& instance, int numJobs, int numMachines, std::string& error) {
+        if (numJobs <= 0 || numMachines <= 0) {
+            error = "job and machine counts must be positive";
+            return false;
+        }
+        instance.numJobs = numJobs;
+        instance.numMachines = numMachines;
+        instance.jobOffset.assign(numJobs + 1, 0);
+        instance.opJob.reserve((size_t)numJobs * numMachines);
+        instance.opMachine.reserve((size_t)numJobs * numMachines);
+        instance.opDuration.reserve((size_t)numJobs * numMachines);
+        return true;
+    }
+
+    bool addOperation(Instance& instance, int job, long long machineID, long long duration, std::string& error) {
+        if (machineID < 0 || machineID >= instance.numMachines) {
+            error = "machine " + std::to_string(machineID) + " out of range in job " + std::to_string(job);
+            return false;
+        }
+        if (duration < 0) {
+            error = "negative duration in job " + std::to_string(job);
+            return false;
+        }
+        instance.opJob.push_back(job);
+        instance.opMachine.push_back((int)machineID);
+        instance.opDuration.push_back((int)duration);
+        return true;
+    }
+
+    bool finishInstance(Instance& instance) {
+        instance.numOps = instance.jobOffset[instance.numJobs];
+        buildMachineLists(instance);
+        return true;
+    }
+
+    // Skip whitespace and consume word if it comes next
+    bool expectWord(const char* word) {
+        while (pos < end && isBlank(*pos)) {
+            ++pos;
+        }
+        size_t length = std::strlen(word);
+        if ((size_t)(end - pos) < length || std::memcmp(pos, word, length) != 0) {
+            return false;
+        }
+        pos += length;
+        return true;
+    }
+
+    // Read the next integer in [p, limit), skipping whitespace; false if
+    // the next token is not an integer or there is none
+    static bool scanInteger(const char*& p, const char* limit, long long& value) {
+        while (p < limit && isBlank(*p)) {
+            ++p;
+        }
+        bool negative = p < limit && *p == '-';
+        const char* digits = negative ? p + 1 : p;
+        if (digits >= limit || *digits < '0' || *digits > '9') {
+            return false;
+        }
+        long long result = 0;
+        for (p = digits; p < limit && *p >= '0' && *p <= '9'; ++p) {
+            result = result * 10 + (*p - '0');
+        }
+        if (p < limit && !isBlank(*p) && *p != ',') {
+            return false;
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+
+    // Number of integers on a line that holds nothing else, reading up to
+    // capacity of them; -1 if it holds anything else
+    static int lineIntegers(const char* p, const char* lineEnd, long long* values, int capacity) {
+        int count = 0;
+        long long value;
+        while (scanInteger(p, lineEnd, value)) {
+            if (count < capacity) {
+                values[count] = value;
+            }
+            ++count;
+        }
+        return skipBlanks(p, lineEnd) == lineEnd ? count : -1;
+    }
+
+    const char* findLineEnd(const char* p) const {
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        return newline ? newline : end;
+    }
+
+    static bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    static const char* skipBlanks(const char* p, const char* limit) {
+        while (p < limit && isBlank(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    static const char* trimEnd(const char* begin, const char* limit) {
+        while (limit > begin && isBlank(limit[-1])) {
+            --limit;
+        }
+        return limit;
+    }
+
+    static bool startsWith(const char* p, const char* limit, const char* prefix) {
+        size_t length = std::strlen(prefix);
+        return (size_t)(limit - p) >= length && std::memcmp(p, prefix, length) == 0;
+    }
+
+    static bool contains(const char* p, const char* limit, const char* word) {
+        size_t length = std::strlen(word);
+        for (; (size_t)(limit - p) >= length; ++p) {
+            if (std::memcmp(p, word, length) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char* pos;
+    const char* end;
+    std::string source;
+};
+
+// Load every instance in a file, mapping it into memory instead of reading
+// it through a stream; false with a message in error on failure
+inline bool loadInstanceFile(const char* path, std::vector<NamedInstance>& instances, std::string& error) {
+    const char* slash = std::strrchr(path, '/');
+    std::string source = slash ? slash + 1 : path;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        error = std::string(path) + ": cannot open";
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        error = std::string(path) + ": empty or unreadable";
+        return false;
+    }
+    size_t size = (size_t)info.st_size;
+    void* data = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        error = std::string(path) + ": cannot map";
+        return false;
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    const char* text = static_cast<const char*>(data);
+    InstanceParser parser(text, text + size, source);
+    bool ok = parser.parse(instances, error);
+    munmap(data, size);
+    return ok;
+}
+
+// The 3-job, 3-machine example the solvers run when given no file
+inline void exampleInstance(std::vector<NamedInstance>& instances) {
+    static const char text[] =
+        "3 3\n"
+        "0 3 1 2 2 2\n"
+        "0 2 1 1 2 4\n"
+        "0 4 1 3 2 3\n";
+    std::string error;
+    InstanceParser(text, text + sizeof(text) - 1, "example").parse(instances, error);
+}
+
+// Instances from every file named on the command line (arguments other than
+// options and their values), or the example when none is named.
+// Prints the error and returns false if a file cannot be loaded.
+inline bool loadCommandLineInstances(int argc, char** argv, std::vector<NamedInstance>& instances) {
+    bool anyFile = false;
+    for (int i = 1; i < argc; ++i) {
+        int optionArguments;
+        if (isOption(argc, argv, i, optionArguments)) {
+            i += optionArguments - 1;
+            continue;
+        }
+        std::string error;
+        if (!loadInstanceFile(argv[i], instances, error)) {
+            std::cerr << error << std::endl;
+            return false;
+        }
+        anyFile = true;
+    }
+    if (!anyFile) {
+        exampleInstance(instances);
+    }
+    return true;
+}
+
+#endif
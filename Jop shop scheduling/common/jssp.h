@@ -0,0 +1,119 @@
+// Shared Job-Shop Scheduling instance layout and makespan evaluator
+#ifndef JSSP_H
+#define JSSP_H
+
+#include <vector>
+#include <algorithm>
+
+#include "fixed_shape.h"
+
+// Job-Shop Scheduling instance in flat form.
+// Operations are numbered job by job: the operations of job j are
+// [jobOffset[j], jobOffset[j + 1]) in technological order.
+struct Instance {
+    int numJobs;
+    int numMachines;
+    int numOps;
+    std::vector<int> jobOffset;      // numJobs + 1 entries
+    std::vector<int> opJob;          // Job of each operation
+    std::vector<int> opMachine;      // Machine of each operation
+    std::vector<int> opDuration;     // Processing time of each operation
+    std::vector<int> machineOffset;  // numMachines + 1 entries
+    std::vector<int> machineOps;     // Operations grouped by machine, by job order
+
+    Instance() : numJobs(0), numMachines(0), numOps(0) {}
+};
+
+// Fill the per-machine operation lists from opMachine
+inline void buildMachineLists(Instance& instance) {
+    instance.machineOffset.assign(instance.numMachines + 1, 0);
+    for (int op = 0; op < instance.numOps; ++op) {
+        ++instance.machineOffset[instance.opMachine[op] + 1];
+    }
+    for (int m = 0; m < instance.numMachines; ++m) {
+        instance.machineOffset[m + 1] += instance.machineOffset[m];
+    }
+
+    instance.machineOps.resize(instance.numOps);
+    std::vector<int> fill(instance.machineOffset.begin(), instance.machineOffset.end() - 1);
+    for (int op = 0; op < instance.numOps; ++op) {
+        instance.machineOps[fill[instance.opMachine[op]]++] = op;
+    }
+}
+
+// True if every job has exactly numMachines operations
+inline bool isUniformShape(const Instance& instance) {
+    for (int j = 0; j <= instance.numJobs; ++j) {
+        if (instance.jobOffset[j] != j * instance.numMachines) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Operation-based schedule with every job repeated once per operation, in job order
+inline void initialSequence(const Instance& instance, std::vector<int>& schedule) {
+    schedule.resize(instance.numOps);
+    for (int op = 0; op < instance.numOps; ++op) {
+        schedule[op] = instance.opJob[op];
+    }
+}
+
+// Makespan evaluator with preallocated machine/job state.
+// A schedule is an operation-based sequence of job IDs: the k-th occurrence
+// of job j schedules operation k of job j. Shapes listed in
+// selectFixedShape() use a decoder compiled for them.
+class Evaluator {
+public:
+    Evaluator() : instance(0), fixedMakespan(0) {}
+    explicit Evaluator(const Instance& inst) { init(inst); }
+
+    void init(const Instance& inst) {
+        instance = &inst;
+        machineTime.assign(inst.numMachines, 0);
+        jobTime.assign(inst.numJobs, 0);
+        nextOp.assign(inst.numJobs, 0);
+        fixedMakespan = selectFixedShape(inst.numJobs, inst.numMachines, isUniformShape(inst)).makespan;
+    }
+
+    // Calculate the makespan of a schedule without allocating
+    int makespan(const int* schedule, int length) {
+        const int* opMachine = instance->opMachine.data();
+        const int* opDuration = instance->opDuration.data();
+        if (fixedMakespan && length == instance->numOps) {
+            return fixedMakespan(opMachine, opDuration, schedule);
+        }
+        int* machine = machineTime.data();
+        int* job = jobTime.data();
+        int* next = nextOp.data();
+
+        std::fill(machineTime.begin(), machineTime.end(), 0);
+        std::fill(jobTime.begin(), jobTime.end(), 0);
+        std::copy(instance->jobOffset.begin(), instance->jobOffset.end() - 1, nextOp.begin());
+
+        int result = 0;
+        for (int i = 0; i < length; ++i) {
+            int jobID = schedule[i];
+            int op = next[jobID]++;
+            int machineID = opMachine[op];
+            int end = std::max(machine[machineID], job[jobID]) + opDuration[op];
+            machine[machineID] = end;
+            job[jobID] = end;
+            result = std::max(result, end);
+        }
+        return result;
+    }
+
+    int makespan(const std::vector<int>& schedule) {
+        return makespan(schedule.data(), (int)schedule.size());
+    }
+
+private:
+    const Instance* instance;
+    FixedMakespanFn fixedMakespan;  // Null for shapes without a compiled decoder
+    std::vector<int> machineTime;
+    std::vector<int> jobTime;
+    std::vector<int> nextOp;
+};
+
+#endif
@@ -0,0 +1,199 @@
+// Makespan evaluator that decodes LANES schedules in lockstep with SIMD
+#ifndef LOCKSTEP_EVALUATOR_H
+#define LOCKSTEP_EVALUATOR_H
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+
+#include "jssp.h"
+#include "simd_dispatch.h"
+
+// Schedules and decoder state are stored structure-of-arrays: entry x of
+// lane l lives at x * LANES + l, so position i of all schedules is one
+// contiguous row and every lane reads and writes its own slots. One decode
+// step handles position i of all lanes with gathers for the job, machine
+// and duration lookups and vector max/add for the completion times.
+class LockstepEvaluator {
+public:
+    static constexpr int LANES = 16;  // Slots are addressed as x << 4 | lane
+
+    LockstepEvaluator() : instance(0), simdLevel(SIMD_SCALAR) {}
+    explicit LockstepEvaluator(const Instance& inst) { init(inst); }
+
+    void init(const Instance& inst, SimdLevel level = detectSimdLevel()) {
+        instance = &inst;
+        simdLevel = level;
+        machineTime.assign((size_t)inst.numMachines * LANES, 0);
+        jobTime.assign((size_t)inst.numJobs * LANES, 0);
+        nextOp.assign((size_t)inst.numJobs * LANES, 0);
+    }
+
+    SimdLevel level() const { return simdLevel; }
+
+    // Decode schedules (numOps rows of LANES job IDs) into makespans and
+    // return the mask of lanes whose makespan is <= their cutoff. As in
+    // IncrementalEvaluator, a lane above its cutoff only gets a value above
+    // cutoff; decoding stops once every lane is known to exceed it.
+    unsigned evaluate(const int* schedules, const int* cutoffs, int* makespans) {
+        reset();
+#if JSSP_X86_SIMD
+        if (simdLevel == SIMD_AVX512) {
+            return evaluateAvx512(schedules, cutoffs, makespans);
+        }
+        if (simdLevel == SIMD_AVX2) {
+            return evaluateAvx2(schedules, cutoffs, makespans);
+        }
+#endif
+        return evaluateScalar(schedules, cutoffs, makespans);
+    }
+
+private:
+    void reset() {
+        std::fill(machineTime.begin(), machineTime.end(), 0);
+        std::fill(jobTime.begin(), jobTime.end(), 0);
+        for (int j = 0; j < instance->numJobs; ++j) {
+            std::fill(nextOp.begin() + (size_t)j * LANES, nextOp.begin() + (size_t)(j + 1) * LANES,
+                      instance->jobOffset[j]);
+        }
+    }
+
+    // One lane at a time, each stopping at its own cutoff
+    unsigned evaluateScalar(const int* schedules, const int* cutoffs, int* makespans) {
+        const int* opMachine = instance->opMachine.data();
+        const int* opDuration = instance->opDuration.data();
+        unsigned accepted = 0;
+        for (int l = 0; l < LANES; ++l) {
+            int* machine = machineTime.data() + l;
+            int* job = jobTime.data() + l;
+            int* next = nextOp.data() + l;
+            int result = 0;
+            for (int i = 0; i < instance->numOps && result <= cutoffs[l]; ++i) {
+                int jobID = schedules[i * LANES + l] * LANES;
+                int op = next[jobID]++;
+                int machineID = opMachine[op] * LANES;
+                int end = std::max(machine[machineID], job[jobID]) + opDuration[op];
+                machine[machineID] = end;
+                job[jobID] = end;
+                result = std::max(result, end);
+            }
+            makespans[l] = result;
+            if (result <= cutoffs[l]) {
+                accepted |= 1u << l;
+            }
+        }
+        return accepted;
+    }
+
+#if JSSP_X86_SIMD
+    // Eight lanes per register; AVX2 has gathers but no scatters, so the
+    // updated state is written back lane by lane
+    __attribute__((target("avx2")))
+    unsigned evaluateAvx2(const int* schedules, const int* cutoffs, int* makespans) {
+        const int* opMachine = instance->opMachine.data();
+        const int* opDuration = instance->opDuration.data();
+        int* machine = machineTime.data();
+        int* job = jobTime.data();
+        int* next = nextOp.data();
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i lane[2] = {_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                 _mm256_setr_epi32(8, 9, 10, 11, 12, 13, 14, 15)};
+        __m256i cutoff[2], result[2];
+        for (int h = 0; h < 2; ++h) {
+            cutoff[h] = _mm256_loadu_si256((const __m256i*)(cutoffs + 8 * h));
+            result[h] = _mm256_setzero_si256();
+        }
+        alignas(32) int jobIndex[8], machineIndex[8], following[8], end[8];
+
+        for (int i = 0; i < instance->numOps; ++i) {
+            for (int h = 0; h < 2; ++h) {
+                __m256i jobID = _mm256_loadu_si256((const __m256i*)(schedules + i * LANES + 8 * h));
+                __m256i jobSlot = _mm256_add_epi32(_mm256_slli_epi32(jobID, 4), lane[h]);
+                __m256i op = _mm256_i32gather_epi32(next, jobSlot, 4);
+                __m256i machineSlot = _mm256_add_epi32(_mm256_slli_epi32(_mm256_i32gather_epi32(opMachine, op, 4), 4), lane[h]);
+                __m256i start = _mm256_max_epi32(_mm256_i32gather_epi32(machine, machineSlot, 4),
+                                                 _mm256_i32gather_epi32(job, jobSlot, 4));
+                __m256i finish = _mm256_add_epi32(start, _mm256_i32gather_epi32(opDuration, op, 4));
+                result[h] = _mm256_max_epi32(result[h], finish);
+
+                _mm256_store_si256((__m256i*)jobIndex, jobSlot);
+                _mm256_store_si256((__m256i*)machineIndex, machineSlot);
+                _mm256_store_si256((__m256i*)following, _mm256_add_epi32(op, one));
+                _mm256_store_si256((__m256i*)end, finish);
+                for (int l = 0; l < 8; ++l) {
+                    next[jobIndex[l]] = following[l];
+                    machine[machineIndex[l]] = end[l];
+                    job[jobIndex[l]] = end[l];
+                }
+            }
+            if ((i & 7) == 7) {
+                __m256i over = _mm256_and_si256(_mm256_cmpgt_epi32(result[0], cutoff[0]),
+                                                _mm256_cmpgt_epi32(result[1], cutoff[1]));
+                if (_mm256_movemask_epi8(over) == -1) {
+                    break;
+                }
+            }
+        }
+
+        unsigned accepted = 0;
+        for (int h = 0; h < 2; ++h) {
+            _mm256_storeu_si256((__m256i*)(makespans + 8 * h), result[h]);
+            __m256i rejected = _mm256_cmpgt_epi32(result[h], cutoff[h]);
+            unsigned bits = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(rejected));
+            accepted |= (~bits & 0xFFu) << (8 * h);
+        }
+        return accepted;
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // False positives inside GCC's AVX-512 headers
+#endif
+    // All sixteen lanes in one register, with scatters for the state updates.
+    // Lanes never share a slot, so the scatters have no conflicts.
+    __attribute__((target("avx512f")))
+    unsigned evaluateAvx512(const int* schedules, const int* cutoffs, int* makespans) {
+        const int* opMachine = instance->opMachine.data();
+        const int* opDuration = instance->opDuration.data();
+        int* machine = machineTime.data();
+        int* job = jobTime.data();
+        int* next = nextOp.data();
+        const __m512i one = _mm512_set1_epi32(1);
+        const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i cutoff = _mm512_loadu_si512(cutoffs);
+        __m512i result = _mm512_setzero_si512();
+
+        for (int i = 0; i < instance->numOps; ++i) {
+            __m512i jobID = _mm512_loadu_si512(schedules + i * LANES);
+            __m512i jobSlot = _mm512_add_epi32(_mm512_slli_epi32(jobID, 4), lane);
+            __m512i op = _mm512_i32gather_epi32(jobSlot, next, 4);
+            _mm512_i32scatter_epi32(next, jobSlot, _mm512_add_epi32(op, one), 4);
+            __m512i machineSlot = _mm512_add_epi32(_mm512_slli_epi32(_mm512_i32gather_epi32(op, opMachine, 4), 4), lane);
+            __m512i start = _mm512_max_epi32(_mm512_i32gather_epi32(machineSlot, machine, 4),
+                                             _mm512_i32gather_epi32(jobSlot, job, 4));
+            __m512i finish = _mm512_add_epi32(start, _mm512_i32gather_epi32(op, opDuration, 4));
+            _mm512_i32scatter_epi32(machine, machineSlot, finish, 4);
+            _mm512_i32scatter_epi32(job, jobSlot, finish, 4);
+            result = _mm512_max_epi32(result, finish);
+
+            if ((i & 7) == 7 && _mm512_cmpgt_epi32_mask(result, cutoff) == 0xFFFF) {
+                break;
+            }
+        }
+
+        _mm512_storeu_si512(makespans, result);
+        return _mm512_cmple_epi32_mask(result, cutoff);
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+    const Instance* instance;
+    SimdLevel simdLevel;
+    std::vector<int> machineTime;  // numMachines rows of LANES
+    std::vector<int> jobTime;      // numJobs rows of LANES
+    std::vector<int> nextOp;       // numJobs rows of LANES
+};
+
+#endif
@@ -0,0 +1,68 @@
+// Lock-free single-sender, single-receiver mailbox for batches of schedules
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <vector>
+#include <atomic>
+
+// One slot that a single sender fills and a single receiver drains. Both
+// sides only try to claim the slot with a compare-and-swap and move on if
+// the other side holds it, so neither ever waits. A post to a full slot
+// replaces the unread batch, so the receiver always gets the newest one.
+class ScheduleMailbox {
+public:
+    ScheduleMailbox() : state(EMPTY), capacity(0), length(0), filled(0) {}
+
+    void init(int batchCapacity, int scheduleLength) {
+        capacity = batchCapacity;
+        length = scheduleLength;
+        filled = 0;
+        genes.assign((size_t)capacity * length, 0);
+        makespans.assign(capacity, 0);
+        state.store(EMPTY);
+    }
+
+    // Sender: claim the slot, write up to capacity schedules, then publish
+    bool beginPost() {
+        int expected = EMPTY;
+        if (state.compare_exchange_strong(expected, WRITING, std::memory_order_acquire)) {
+            return true;
+        }
+        expected = FULL;
+        return state.compare_exchange_strong(expected, WRITING, std::memory_order_acquire);
+    }
+
+    void endPost(int count) {
+        filled = count;
+        state.store(FULL, std::memory_order_release);
+    }
+
+    // Receiver: claim a published batch, read it, then release the slot
+    bool beginCollect() {
+        int expected = FULL;
+        return state.compare_exchange_strong(expected, READING, std::memory_order_acquire);
+    }
+
+    void endCollect() {
+        state.store(EMPTY, std::memory_order_release);
+    }
+
+    int count() const { return filled; }
+    int* schedule(int i) { return &genes[(size_t)i * length]; }
+    int& makespan(int i) { return makespans[i]; }
+
+private:
+    enum { EMPTY, WRITING, FULL, READING };
+
+    ScheduleMailbox(const ScheduleMailbox&);
+    ScheduleMailbox& operator=(const ScheduleMailbox&);
+
+    std::atomic<int> state;
+    int capacity;
+    int length;
+    int filled;
+    std::vector<int> genes;
+    std::vector<int> makespans;
+};
+
+#endif
@@ -0,0 +1,159 @@
+// Contiguous float pheromone matrix with SIMD or lazy evaporation
+#ifndef PHEROMONE_MATRIX_H
+#define PHEROMONE_MATRIX_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cfloat>
+
+#include "simd_dispatch.h"
+
+// rows x cols trails in one 64-byte aligned block, each row padded to a
+// whole number of cache lines. Values stay within [lower, upper]: the
+// default lower bound is the floor given to init(), so float storage cannot
+// underflow into denormals however long a trail evaporates, and setBounds()
+// gives the tighter limits of Max-Min Ant System.
+//
+// Eager evaporation scales the whole block once per iteration with the
+// widest SIMD kernel available. Lazy evaporation only advances a clock; each
+// row remembers the iteration it was last brought up to date and catches up
+// on the missed decay when it is read or receives a deposit.
+class PheromoneMatrix {
+public:
+    PheromoneMatrix() : numRows(0), numCols(0), stride(0), data(0), retain(1.0), lowest(0.0f),
+                        highest(FLT_MAX), lazyDecay(false), clock(0), simdLevel(SIMD_SCALAR) {}
+
+    void init(int rows, int cols, float initial, double evaporation, bool lazy, float floor) {
+        numRows = rows;
+        numCols = cols;
+        stride = (cols + 15) / 16 * 16;
+        storage.assign((size_t)rows * stride + 16, initial);
+        size_t misalignment = (reinterpret_cast<uintptr_t>(storage.data()) / sizeof(float)) % 16;
+        data = storage.data() + (16 - misalignment) % 16;
+        retain = 1.0 - evaporation;
+        lowest = floor;
+        highest = FLT_MAX;
+        lazyDecay = lazy;
+        clock = 0;
+        rowClock.assign(rows, 0);
+        simdLevel = detectSimdLevel();
+    }
+
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+
+    // One evaporation step for every trail
+    void evaporate() {
+        ++clock;
+        if (!lazyDecay) {
+            scale(data, (size_t)numRows * stride, (float)retain);
+            std::fill(rowClock.begin(), rowClock.end(), clock);
+        }
+    }
+
+    // Up-to-date trails of row r
+    const float* row(int r) {
+        catchUp(r);
+        return data + (size_t)r * stride;
+    }
+
+    void deposit(int r, int c, float amount) {
+        catchUp(r);
+        float& trail = data[(size_t)r * stride + c];
+        trail = std::min(trail + amount, highest);
+    }
+
+    // Clamp every trail to [lower, upper] from now on
+    void setBounds(float lower, float upper) {
+        lowest = lower;
+        highest = upper;
+        for (int r = 0; r < numRows; ++r) {
+            catchUp(r);
+        }
+        scale(data, (size_t)numRows * stride, 1.0f);
+    }
+
+    // Set every trail to value
+    void reset(float value) {
+        std::fill(storage.begin(), storage.end(), std::min(std::max(value, lowest), highest));
+        std::fill(rowClock.begin(), rowClock.end(), clock);
+    }
+
+private:
+    PheromoneMatrix(const PheromoneMatrix&);
+    PheromoneMatrix& operator=(const PheromoneMatrix&);
+
+    // Apply the decay row r missed since it was last touched
+    void catchUp(int r) {
+        if (rowClock[r] != clock) {
+            scale(data + (size_t)r * stride, stride, (float)std::pow(retain, (double)(clock - rowClock[r])));
+            rowClock[r] = clock;
+        }
+    }
+
+    // values[i] = clamp(values[i] * factor, lowest, highest)
+    void scale(float* values, size_t count, float factor) {
+#if JSSP_X86_SIMD
+        if (simdLevel == SIMD_AVX512) {
+            scaleAvx512(values, count, factor);
+            return;
+        }
+        if (simdLevel == SIMD_AVX2) {
+            scaleAvx2(values, count, factor);
+            return;
+        }
+#endif
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = std::min(std::max(values[i] * factor, lowest), highest);
+        }
+    }
+
+#if JSSP_X86_SIMD
+    // Rows start on 64-byte boundaries and span whole cache lines
+    __attribute__((target("avx2")))
+    void scaleAvx2(float* values, size_t count, float factor) {
+        __m256 f = _mm256_set1_ps(factor);
+        __m256 floor = _mm256_set1_ps(lowest);
+        __m256 ceiling = _mm256_set1_ps(highest);
+        for (size_t i = 0; i < count; i += 8) {
+            __m256 scaled = _mm256_mul_ps(_mm256_load_ps(values + i), f);
+            _mm256_store_ps(values + i, _mm256_min_ps(_mm256_max_ps(scaled, floor), ceiling));
+        }
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // False positives inside GCC's AVX-512 headers
+#endif
+    __attribute__((target("avx512f")))
+    void scaleAvx512(float* values, size_t count, float factor) {
+        __m512 f = _mm512_set1_ps(factor);
+        __m512 floor = _mm512_set1_ps(lowest);
+        __m512 ceiling = _mm512_set1_ps(highest);
+        for (size_t i = 0; i < count; i += 16) {
+            __m512 scaled = _mm512_mul_ps(_mm512_load_ps(values + i), f);
+            _mm512_store_ps(values + i, _mm512_min_ps(_mm512_max_ps(scaled, floor), ceiling));
+        }
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+    int numRows;
+    int numCols;
+    int stride;                    // Floats per row, a multiple of 16
+    float* data;                   // First row, 64-byte aligned inside storage
+    double retain;                 // 1 - evaporation
+    float lowest;
+    float highest;
+    bool lazyDecay;
+    long long clock;               // Evaporation steps so far
+    std::vector<long long> rowClock;
+    std::vector<float> storage;
+    SimdLevel simdLevel;
+};
+
+#endif
@@ -0,0 +1,108 @@
+// Seedable xoshiro256** random streams shared by all solvers
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "command_line.h"
+
+// SplitMix64 step, used to expand seeds into generator states
+inline uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256** generator. Random(seed, stream) gives statistically
+// independent streams of one master seed, so every thread, chain or ant can
+// own a stream that depends only on its index, never on scheduling. It also
+// satisfies UniformRandomBitGenerator for std::shuffle and friends.
+class Random {
+public:
+    typedef uint64_t result_type;
+
+    Random() { seed(0); }
+    explicit Random(uint64_t masterSeed, uint64_t stream = 0) { seed(masterSeed, stream); }
+
+    void seed(uint64_t masterSeed, uint64_t stream = 0) {
+        uint64_t mix = stream;
+        uint64_t state = masterSeed ^ splitMix64(mix);
+        for (int i = 0; i < 4; ++i) {
+            s[i] = splitMix64(state);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform integer in [0, bound) for bound > 0, without modulo bias
+    // (Lemire's multiply-and-reject; the division only runs on the rare
+    // draws that land in the biased sliver)
+    int below(int bound) {
+        uint32_t range = (uint32_t)bound;
+        uint64_t product = (uint64_t)(uint32_t)((*this)() >> 32) * range;
+        uint32_t low = (uint32_t)product;
+        if (low < range) {
+            uint32_t threshold = (0u - range) % range;
+            while (low < threshold) {
+                product = (uint64_t)(uint32_t)((*this)() >> 32) * range;
+                low = (uint32_t)product;
+            }
+        }
+        return (int)(product >> 32);
+    }
+
+    // Uniform double in [0, 1) from the top 53 bits
+    double unit() {
+        return (double)((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    // count uniform doubles in [0, 1)
+    void units(double* out, int count) {
+        for (int i = 0; i < count; ++i) {
+            out[i] = (double)((*this)() >> 11) * 0x1.0p-53;
+        }
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t s[4];
+};
+
+// Master seed from "--seed N" or "--seed=N" on the command line, or a fresh
+// one from random_device when absent. Print it to reproduce a run.
+inline uint64_t parseSeed(int argc, char** argv) {
+    const char* value = optionValue(argc, argv, "--seed");
+    if (value) {
+        char* end = 0;
+        uint64_t seed = std::strtoull(value, &end, 10);
+        if (*value == '\0' || *end != '\0') {
+            std::cerr << "Invalid seed: " << value << std::endl;
+            std::exit(1);
+        }
+        return seed;
+    }
+    std::random_device device;
+    return ((uint64_t)device() << 32) | device();
+}
+
+#endif
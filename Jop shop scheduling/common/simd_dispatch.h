@@ -0,0 +1,39 @@
+// Runtime detection of the vector instruction sets the kernels can use
+#ifndef SIMD_DISPATCH_H
+#define SIMD_DISPATCH_H
+
+// The AVX2/AVX-512 kernels are compiled per function with target
+// attributes, so the rest of the program needs no -mavx flags and still
+// runs on CPUs without them.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define JSSP_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define JSSP_X86_SIMD 0
+#endif
+
+enum SimdLevel { SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512 };
+
+// Widest instruction set supported by both the build and the running CPU
+inline SimdLevel detectSimdLevel() {
+#if JSSP_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SIMD_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SIMD_AVX2;
+    }
+#endif
+    return SIMD_SCALAR;
+}
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SIMD_AVX512: return "AVX-512";
+        case SIMD_AVX2: return "AVX2";
+        default: return "scalar";
+    }
+}
+
+#endif
@@ -0,0 +1,112 @@
+// Minimal persistent thread pool for parallel loops in the solvers
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+
+// Runs loop bodies over [0, count) on numThreads threads, the calling thread
+// included. Chunks are handed out through a shared atomic counter, so idle
+// threads keep taking work until the range is exhausted. Bodies receive the
+// index of the thread running them, for per-thread scratch buffers.
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads)
+        : stop(false), generation(0), active(0), count(0), chunk(1), nextIndex(0), body(0) {
+        for (int t = 1; t < numThreads; ++t) {
+            workers.push_back(std::thread(&ThreadPool::workerLoop, this, t));
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+    }
+
+    int size() const { return (int)workers.size() + 1; }
+
+    // Call body(begin, end, thread) for chunks of [0, count); returns when all are done
+    void parallelFor(int count, int chunk, const std::function<void(int, int, int)>& body) {
+        if (workers.empty()) {
+            if (count > 0) {
+                body(0, count, 0);
+            }
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            this->body = &body;
+            this->count = count;
+            this->chunk = std::max(1, chunk);
+            nextIndex.store(0);
+            active = (int)workers.size();
+            ++generation;
+        }
+        wake.notify_all();
+        runChunks(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return active == 0; });
+        this->body = 0;
+    }
+
+private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    void workerLoop(int thread) {
+        long long seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stop || generation != seen; });
+                if (stop) {
+                    return;
+                }
+                seen = generation;
+            }
+            runChunks(thread);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--active == 0) {
+                    done.notify_one();
+                }
+            }
+        }
+    }
+
+    void runChunks(int thread) {
+        for (;;) {
+            int begin = nextIndex.fetch_add(chunk);
+            if (begin >= count) {
+                return;
+            }
+            (*body)(begin, std::min(begin + chunk, count), thread);
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    bool stop;
+    long long generation;
+    int active;
+    int count;
+    int chunk;
+    std::atomic<int> nextIndex;
+    const std::function<void(int, int, int)>* body;
+};
+
+#endif
@@ -0,0 +1,104 @@
+// Zobrist fingerprints of schedules and a bounded visited set
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "random.h"
+
+// Random 64-bit key per (row, col) attribute, e.g. (position, job) for a
+// schedule or (operation, machine position) for machine sequences. The hash
+// of a solution is the XOR of the keys of its attributes, so moving a value
+// between two rows changes the hash by four keys.
+class ZobristTable {
+public:
+    ZobristTable() : cols(0) {}
+
+    void init(int rows, int numCols, uint64_t seed = 0x9E3779B97F4A7C15ULL) {
+        cols = numCols;
+        keys.resize((size_t)rows * cols);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            keys[i] = splitMix64(seed);
+        }
+    }
+
+    uint64_t key(int row, int col) const {
+        return keys[(size_t)row * cols + col];
+    }
+
+    // Hash of a sequence, with row = position and col = value
+    uint64_t hash(const int* values, int length) const {
+        uint64_t h = 0;
+        for (int i = 0; i < length; ++i) {
+            h ^= key(i, values[i]);
+        }
+        return h;
+    }
+
+    // Hash change when rows row1 and row2 exchange their values col1 and col2
+    uint64_t swapDelta(int row1, int col1, int row2, int col2) const {
+        return key(row1, col1) ^ key(row1, col2) ^ key(row2, col2) ^ key(row2, col1);
+    }
+
+private:
+    int cols;
+    std::vector<uint64_t> keys;
+};
+
+// Open-addressing set of 64-bit fingerprints with a fixed number of slots.
+// It is cleared once half full, so memory stays bounded and only recent
+// history is remembered.
+class VisitedSet {
+public:
+    VisitedSet() : mask(0), count(0) {}
+
+    void init(int capacityLog2) {
+        slots.assign((size_t)1 << capacityLog2, 0);
+        mask = slots.size() - 1;
+        count = 0;
+    }
+
+    bool contains(uint64_t h) const {
+        h = nonZero(h);
+        for (size_t i = (size_t)h & mask; slots[i] != 0; i = (i + 1) & mask) {
+            if (slots[i] == h) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Add a fingerprint; returns false if it was already present
+    bool insert(uint64_t h) {
+        h = nonZero(h);
+        size_t i = (size_t)h & mask;
+        for (; slots[i] != 0; i = (i + 1) & mask) {
+            if (slots[i] == h) {
+                return false;
+            }
+        }
+        if (2 * (count + 1) > slots.size()) {
+            clear();
+            i = (size_t)h & mask;
+        }
+        slots[i] = h;
+        ++count;
+        return true;
+    }
+
+    void clear() {
+        std::fill(slots.begin(), slots.end(), 0);
+        count = 0;
+    }
+
+private:
+    static uint64_t nonZero(uint64_t h) { return h != 0 ? h : 1; }  // 0 marks an empty slot
+
+    std::vector<uint64_t> slots;
+    size_t mask;
+    size_t count;
+};
+
+#endif